@@ -1,11 +1,19 @@
 #ifndef MICROPYTHON_WRAP_CLASSWRAPPER
 #define MICROPYTHON_WRAP_CLASSWRAPPER
 
+#include "detail/buffer.h"
 #include "detail/callreturn.h"
+#include "detail/finalizerqueue.h"
 #include "detail/functioncall.h"
+#include "detail/generator.h"
 #include "detail/index.h"
+#include "detail/objectpool.h"
 #include "detail/util.h"
+#include "util.h"
+#include <algorithm>
 #include <cstdint>
+#include <iterator>
+#include <new>
 #include <vector>
 #if UPYWRAP_SHAREDPTROBJ
 #include <memory>
@@ -13,11 +21,91 @@
 
 namespace upywrap
 {
+  namespace detail
+  {
+    template< class T, class It >
+    struct NativeIterator;
+
+    //Type object of a ClassWrapper followed by what identifies it as such.
+    //Instances only point to their type so this is where AsNativeObjChecked looks when
+    //an argument's type isn't exactly the one expected, without spending memory per instance.
+    struct ClassWrapperType
+    {
+      mp_obj_full_type_t type; //must always be the first member!
+      std::int64_t cookie; //we'll use this to check if a type really belongs to a ClassWrapper
+      std::size_t inlineOffset; //where T starts in instances with InlineStorage, 0 if they hold a pointer instead
+#if UPYWRAP_FULLTYPECHECK
+      const std::type_info* typeId; //and this will be used to check if types aren't being mixed
+#endif
+    };
+
+    //Key of the entry in the locals dict of a ClassWrapperType referring to the type itself.
+    //Since it goes through the qstr pool it is the same for all modules, e.g. another dll.
+    inline qstr ClassWrapperTypeMarker()
+    {
+      static const qstr marker = qstr_from_str( "__classwrapper__" );
+      return marker;
+    }
+
+    //Get t as ClassWrapperType if it is one, else nullptr. Any other type, builtin or not, might not be
+    //followed by anything, so this first checks for the marker using nothing but the type's locals dict.
+    inline const ClassWrapperType* AsClassWrapperType( const mp_obj_type_t* t )
+    {
+      if( !MP_OBJ_TYPE_HAS_SLOT( t, locals_dict ) )
+      {
+        return nullptr;
+      }
+      auto locals_map = &MP_OBJ_TYPE_GET_SLOT( t, locals_dict )->map;
+      const auto elem = mp_map_lookup( locals_map, new_qstr( ClassWrapperTypeMarker() ), MP_MAP_LOOKUP );
+      if( !elem || elem->value != MP_OBJ_FROM_PTR( t ) )
+      {
+        return nullptr;
+      }
+      return (const ClassWrapperType*) t;
+    }
+  }
+
   inline bool FullTypeCheck()
   {
     return UPYWRAP_FULLTYPECHECK == 1;
   }
 
+  //Specialize this as std::true_type to have ClassWrapper< T > store T by value, constructed in place
+  //right after the instance header in the uPy heap block, instead of pointing to a separately allocated T.
+  //That is one allocation per instance instead of two and accessing T is a fixed offset, which is what you
+  //want for small value-like types (points, timestamps, ...) which get created in large numbers:
+  //
+  //template<>
+  //struct InlineStorage< Point > : std::true_type
+  //{
+  //};
+  //
+  //Since there is no separate native object such types have value semantics: they can be returned by value
+  //(moved into the new instance), but returning them by reference or shared_ptr also stores a copy.
+  //Functions taking a shared_ptr< T > get one which keeps the uPy object alive.
+  template< class T >
+  struct InlineStorage : std::false_type
+  {
+  };
+
+  /**
+    * Declare a bunch of common special method names.
+    */
+  struct special_methods
+  {
+    func_name_def( __str__ )
+    func_name_def( __repr__ )
+    func_name_def( __bytes__ )
+    func_name_def( __format__ )
+    func_name_def( __iter__ )
+    func_name_def( __next__ )
+    func_name_def( __reversed__ )
+    func_name_def( __call__ )
+    func_name_def( __getitem__ )
+    func_name_def( __setitem__ )
+    func_name_def( __delitem__ )
+  };
+
   //Main logic for registering classes and their functions.
   //Usage:
   //
@@ -38,6 +126,13 @@ namespace upywrap
   //wrap.Def< Funcs::Foo >( &SomeClass::Foo );
   //wrap.Def< Funcs::Bar >( &SomeClass::Bar, Kwargs( "a", mp_const_none )( "b", 0 ) );
   //
+  //With C++17 the function can also be passed as template argument:
+  //
+  //wrap.Def< Funcs::Foo, &SomeClass::Foo >();
+  //
+  //which doesn't need to store the function so is faster to call, but does not support
+  //a return value converter.
+  //
   //This will register type "SomeClass" and given functions in dict,
   //so if dict is the global dict of a module "mod", the class
   //can be used in uPy like this:
@@ -58,6 +153,17 @@ namespace upywrap
 #else
     using native_obj_t = T*;
 #endif
+    //Whether T is stored in the instance itself, see InlineStorage.
+    static constexpr bool storeInline = InlineStorage< T >::value;
+
+    //Whether instances need del to run when collected. Not the case if T is stored inline and is trivially
+    //destructible, so such instances are allocated without finaliser which keeps them out of the GC's
+    //finaliser handling during sweeps.
+    static constexpr bool needsFinaliser = !( storeInline && std::is_trivially_destructible< T >::value );
+
+    //When native objects get destroyed, see DestructionMode.
+    static constexpr Destruction destruction = DestructionMode< T >::value;
+
     //Just to make it clear what the intent is.
     enum class ConstructorOptions
     {
@@ -77,26 +183,26 @@ namespace upywrap
     ClassWrapper( const char* name, mp_obj_dict_t* dict, decltype( mp_obj_type_t::flags ) flags = 0 ) :
       ClassWrapper( name, flags )
     {
-      mp_obj_dict_store( dict, new_qstr( name ), &type );
-      mp_obj_dict_store( dict, new_qstr( ( std::string( name ) + "_locals" ).data() ), MP_OBJ_FROM_PTR( MP_OBJ_TYPE_GET_SLOT( &type, locals_dict ) ) );
+      mp_obj_dict_store( dict, new_qstr( name ), &wrapped.type );
+      mp_obj_dict_store( dict, new_qstr( ( std::string( name ) + "_locals" ).data() ), MP_OBJ_FROM_PTR( MP_OBJ_TYPE_GET_SLOT( &wrapped.type, locals_dict ) ) );
     }
 
     //Initialize the type, storing the locals in StaticPyObjectStore to prevent GC collection.
     ClassWrapper( const char* name, ConstructorOptions, decltype( mp_obj_type_t::flags ) flags = 0 ) :
       ClassWrapper( name, flags )
     {
-      StaticPyObjectStore::Store( MP_OBJ_FROM_PTR( MP_OBJ_TYPE_GET_SLOT( &type, locals_dict ) ) );
+      StaticPyObjectStore::Store( MP_OBJ_FROM_PTR( MP_OBJ_TYPE_GET_SLOT( &wrapped.type, locals_dict ) ) );
     }
 
     static const mp_obj_type_t& Type()
     {
-      return *((const mp_obj_type_t*) &type);
+      return *((const mp_obj_type_t*) &wrapped.type);
     }
 
     template< class A >
     void StoreClassVariable( const char* name, const A& value )
     {
-      mp_obj_dict_store( MP_OBJ_FROM_PTR( MP_OBJ_TYPE_GET_SLOT( &type, locals_dict ) ), new_qstr( name ), ToPy( value ) );
+      AddFunctionToTable( name, ToPy( value ) );
     }
 
     template< index_type name, class Ret, class... A >
@@ -183,6 +289,14 @@ namespace upywrap
       DefImpl< name, Ret, decltype( f ), A... >( f, std::move( arguments ), conv );
     }
 
+#if UPYWRAP_HAS_CPP17
+    template< index_type name, auto f >
+    void Def( Arguments arguments = Arguments() )
+    {
+      DefBound< name, f >( f, std::move( arguments ) );
+    }
+#endif
+
     template< class A >
     void Setter( const char* name, void( *f )( T*, A ) )
     {
@@ -221,6 +335,182 @@ namespace upywrap
       GetterImpl< decltype( fget ), A >( name, fget );
     }
 
+    //Register a native function for a binary operator, e.g. DefBinaryOp< MP_BINARY_OP_ADD >( &T::Add ).
+    //This is the same as using Def with the operator's method name (__add__ etc) but binary_op
+    //calls the native function directly instead of looking up the method and calling it via uPy.
+    template< mp_binary_op_t op, class Ret, class A >
+    void DefBinaryOp( Ret( T::*f ) ( A ), typename SelectRetvalConverter< Ret >::type conv = nullptr )
+    {
+      BinaryOpImpl< op, Ret, decltype( f ), A >( f, conv );
+    }
+
+    template< mp_binary_op_t op, class Ret, class A >
+    void DefBinaryOp( Ret( T::*f ) ( A ) const, typename SelectRetvalConverter< Ret >::type conv = nullptr )
+    {
+      BinaryOpImpl< op, Ret, decltype( f ), A >( f, conv );
+    }
+
+    template< mp_binary_op_t op, class Ret, class A >
+    void DefBinaryOp( Ret( *f ) ( T*, A ), typename SelectRetvalConverter< Ret >::type conv = nullptr )
+    {
+      BinaryOpImpl< op, Ret, decltype( f ), A >( f, conv );
+    }
+
+    template< mp_binary_op_t op, class Ret, class A >
+    void DefBinaryOp( Ret( *f ) ( T&, A ), typename SelectRetvalConverter< Ret >::type conv = nullptr )
+    {
+      BinaryOpImpl< op, Ret, decltype( f ), A >( f, conv );
+    }
+
+    template< mp_binary_op_t op, class Ret, class A >
+    void DefBinaryOp( Ret( *f ) ( const T&, A ), typename SelectRetvalConverter< Ret >::type conv = nullptr )
+    {
+      BinaryOpImpl< op, Ret, decltype( f ), A >( f, conv );
+    }
+
+    //Register a native function for a unary operator, e.g. DefUnaryOp< MP_UNARY_OP_LEN >( &T::size ).
+    //Like DefBinaryOp this also registers the method (__len__ etc) but unary_op calls the native function directly.
+    //Note uPy requires MP_UNARY_OP_LEN to return an integer which fits in a small int.
+    //For MP_UNARY_OP_HASH that is taken care of: results outside the small int range get folded into it.
+    template< mp_unary_op_t op, class Ret >
+    void DefUnaryOp( Ret( T::*f ) (), typename SelectRetvalConverter< Ret >::type conv = nullptr )
+    {
+      UnaryOpImpl< op, Ret, decltype( f ) >( f, conv );
+    }
+
+    template< mp_unary_op_t op, class Ret >
+    void DefUnaryOp( Ret( T::*f ) () const, typename SelectRetvalConverter< Ret >::type conv = nullptr )
+    {
+      UnaryOpImpl< op, Ret, decltype( f ) >( f, conv );
+    }
+
+    template< mp_unary_op_t op, class Ret >
+    void DefUnaryOp( Ret( *f ) ( T* ), typename SelectRetvalConverter< Ret >::type conv = nullptr )
+    {
+      UnaryOpImpl< op, Ret, decltype( f ) >( f, conv );
+    }
+
+    template< mp_unary_op_t op, class Ret >
+    void DefUnaryOp( Ret( *f ) ( T& ), typename SelectRetvalConverter< Ret >::type conv = nullptr )
+    {
+      UnaryOpImpl< op, Ret, decltype( f ) >( f, conv );
+    }
+
+    template< mp_unary_op_t op, class Ret >
+    void DefUnaryOp( Ret( *f ) ( const T& ), typename SelectRetvalConverter< Ret >::type conv = nullptr )
+    {
+      UnaryOpImpl< op, Ret, decltype( f ) >( f, conv );
+    }
+
+    //Register native functions for obj[index], obj[index] = value and del obj[index].
+    //These are also registered as __getitem__/__setitem__/__delitem__ but the subscr slot
+    //calls the native functions directly.
+    template< class Ret, class A >
+    void DefGetItem( Ret( T::*f ) ( A ), typename SelectRetvalConverter< Ret >::type conv = nullptr )
+    {
+      GetItemImpl< Ret, decltype( f ), A >( f, conv );
+    }
+
+    template< class Ret, class A >
+    void DefGetItem( Ret( T::*f ) ( A ) const, typename SelectRetvalConverter< Ret >::type conv = nullptr )
+    {
+      GetItemImpl< Ret, decltype( f ), A >( f, conv );
+    }
+
+    template< class Ret, class A >
+    void DefGetItem( Ret( *f ) ( T&, A ), typename SelectRetvalConverter< Ret >::type conv = nullptr )
+    {
+      GetItemImpl< Ret, decltype( f ), A >( f, conv );
+    }
+
+    template< class Ret, class A >
+    void DefGetItem( Ret( *f ) ( const T&, A ), typename SelectRetvalConverter< Ret >::type conv = nullptr )
+    {
+      GetItemImpl< Ret, decltype( f ), A >( f, conv );
+    }
+
+    template< class A, class V >
+    void DefSetItem( void( T::*f ) ( A, V ) )
+    {
+      SetItemImpl< decltype( f ), A, V >( f );
+    }
+
+    template< class A, class V >
+    void DefSetItem( void( *f ) ( T&, A, V ) )
+    {
+      SetItemImpl< decltype( f ), A, V >( f );
+    }
+
+    template< class A >
+    void DefDelItem( void( T::*f ) ( A ) )
+    {
+      DelItemImpl< decltype( f ), A >( f );
+    }
+
+    template< class A >
+    void DefDelItem( void( *f ) ( T&, A ) )
+    {
+      DelItemImpl< decltype( f ), A >( f );
+    }
+
+    //Expose contiguous native memory via the buffer protocol so memoryview( obj ), array functions etc
+    //can access it without copying. data returns a pointer to the first element and size the number of elements;
+    //typecode defaults to the one matching the element type.
+    //Since nothing is copied the buffer is only valid as long as the object lives and the memory doesn't get reallocated.
+    template< class D, class S >
+    void DefBuffer( D*( T::*data ) (), S( T::*size ) () const, char typecode = BufferTypeCode< D >::value, bool writable = true )
+    {
+      BufferImpl< D >( data, size, typecode, writable );
+    }
+
+    template< class D, class S >
+    void DefBuffer( const D*( T::*data ) () const, S( T::*size ) () const, char typecode = BufferTypeCode< D >::value )
+    {
+      BufferImpl< D >( data, size, typecode, false );
+    }
+
+    //Make instances iterators with a native iternext: iter( obj ) returns obj itself and next( obj ) calls f
+    //directly, which must return the next item converted to a uPy object, or MP_OBJ_STOP_ITERATION when done.
+    //This is the low-level building block for iterator types, e.g. the one used for Generator.
+    void DefIterNext( mp_obj_t( *f ) ( T& ) )
+    {
+      iterNext = f;
+      wrapped.type.flags |= MP_TYPE_FLAG_ITER_IS_ITERNEXT;
+      MP_OBJ_TYPE_SET_SLOT( &wrapped.type, iter, iternext, 8 );
+    }
+
+    //Make instances iterable natively: iter( obj ) creates a lightweight iterator object holding the
+    //native iterators returned by begin and end, plus a reference to obj so it stays alive, and next()
+    //on that converts the current item and increments the iterator without going through uPy methods.
+    //The native iterators are stored in the iterator object itself so that is the only allocation, and it
+    //has no finaliser either if the native iterator type is trivially destructible (e.g. for std::vector).
+    //Without arguments std::begin/std::end are used, which is also what to use if T has both
+    //const and non-const begin/end since those cannot be passed here without casting.
+    //As with native iterators in general, the object must not be modified while iterating.
+    void DefIter()
+    {
+      typedef decltype( std::begin( std::declval< T& >() ) ) iterator_type;
+      IterImpl< iterator_type >( &StdBegin< iterator_type >, &StdEnd< iterator_type > );
+    }
+
+    template< class It >
+    void DefIter( It( T::*begin ) (), It( T::*end ) () )
+    {
+      IterImpl< It >( begin, end );
+    }
+
+    template< class It >
+    void DefIter( It( T::*begin ) () const, It( T::*end ) () const )
+    {
+      IterImpl< It >( begin, end );
+    }
+
+    template< class It >
+    void DefIter( It( *begin ) ( const T& ), It( *end ) ( const T& ) )
+    {
+      IterImpl< It >( begin, end );
+    }
+
     void DefInit()
     {
       DefInit<>();
@@ -229,13 +519,13 @@ namespace upywrap
     template< class... A >
     void DefInit()
     {
-      DefInit( ConstructorFactoryFunc< A... > );
+      DefInit< A... >( Arguments() );
     }
 
     template< class... A >
     void DefInit( Arguments arguments )
     {
-      DefInit( ConstructorFactoryFunc< A... >, std::move( arguments ) );
+      DefaultInitImpl< A... >( std::move( arguments ), inline_tag() );
     }
 
     template< class... A >
@@ -287,9 +577,10 @@ namespace upywrap
     //type ClassWrapper< B > and B derives from A, then B.Cast(a) gives the expected thing.
     //Also see classnt.py test.
     //Use with caution: see comments in AsNativeObjChecked.
+    //For types with InlineStorage this returns a copy.
     static mp_obj_t Cast( mp_obj_t other )
     {
-      return AsPyObj( AsNativeObjChecked( other )->obj );
+      return Cast( other, inline_tag() );
     }
 
 #if UPYWRAP_SHAREDPTROBJ
@@ -310,14 +601,11 @@ namespace upywrap
 
     static mp_obj_t AsPyObj( native_obj_t p )
     {
+      static_assert( !storeInline, "Types with InlineStorage cannot refer to a separately allocated object, use NewInline" );
       assert( p );
       CheckTypeIsRegistered();
-      auto o = (this_type*) m_malloc_with_finaliser( sizeof( this_type ) );
-      o->base.type = (const mp_obj_type_t*) & type;
-      o->cookie = defCookie;
-#if UPYWRAP_FULLTYPECHECK
-      o->typeId = &typeid( T );
-#endif
+      auto o = (this_type*) m_malloc_with_finaliser( InstanceSize() );
+      o->base.type = (const mp_obj_type_t*) & wrapped.type;
 #if UPYWRAP_SHAREDPTROBJ
       new( &o->obj ) native_obj_t( std::move( p ) );
 #else
@@ -326,16 +614,44 @@ namespace upywrap
       return o;
     }
 
+    //Counters of the pool used for constructing T, see PoolSize.
+    static const PoolStats& PoolStatistics()
+    {
+      return detail::ObjectPool< T >::Stats();
+    }
+
+    //Number of bytes allocated on the uPy heap per instance.
+    static constexpr std::size_t InstanceSize()
+    {
+      return storeInline ? InlineOffset() + sizeof( T ) : sizeof( this_type );
+    }
+
+    //Create a new instance for a type with InlineStorage, constructing T in place from the arguments.
+    template< class... Args >
+    static mp_obj_t NewInline( Args&&... args )
+    {
+      static_assert( storeInline, "NewInline requires InlineStorage< T >" );
+      static_assert( alignof( T ) <= MICROPY_BYTES_PER_GC_BLOCK, "InlineStorage requires T's alignment to be supported by the uPy heap" );
+      CheckTypeIsRegistered();
+      auto o = (this_type*) ( needsFinaliser ? m_malloc_with_finaliser( InstanceSize() ) : m_malloc( InstanceSize() ) );
+      //The finaliser skips objects without a type, so only set it once T is constructed:
+      //if the constructor throws the block just becomes garbage without del getting called.
+      new( o->InlinePtr() ) T( std::forward< Args >( args )... );
+      o->base.type = (const mp_obj_type_t*) & wrapped.type;
+      return o;
+    }
+
     static ClassWrapper< T >* AsNativeObjCheckedImpl( mp_obj_t arg )
     {
       auto native = (this_type*) MP_OBJ_TO_PTR( arg );
-      if( !mp_obj_is_exact_type( arg, (const mp_obj_type_t*) &type ) )
+      if( !mp_obj_is_exact_type( arg, (const mp_obj_type_t*) &wrapped.type ) )
       {
         //If whatever gets passed in doesn't remotely look like an object bail out.
         //Otherwise it's possible we're being passed an arbitrary 'opaque' ClassWrapper (so the cookie mathches)
         //which has not been registered or has been registered elsewhere (e.g. another dll, which makes
         //mp_obj_is_exact_type fail since that just compares pointers)
-        //but if it's the same C++ type (or that check is disabled) we're good to go after all.
+        //but if it's the same C++ type (or that check is disabled) and the native object is stored
+        //the same way we're good to go after all.
         //With UPYWRAP_FULLTYPECHECK off, another possibility which makes sense is this gets called from
         //ClassWrapper< B > and arg is actually a ClassWrapper< A >, but B derives from A or vice-versa:
         //in that case, as long as the memory layout of A and B is similar, i.e. for
@@ -352,11 +668,7 @@ namespace upywrap
         //in the constructor by passing the type_info of the class(es) from which T derives - or in
         //case of an opaque wrapper, which effectively is the same as T - and a function for casting,
         //preferrably using dynamic_cast or dynamic_pointer_cast to double-check errors.
-        if( !mp_obj_is_obj( arg ) || native->cookie != defCookie
-#if UPYWRAP_FULLTYPECHECK
-            || typeid( T ) != *native->typeId
-#endif
-            )
+        if( !mp_obj_is_obj( arg ) || !IsWrappedType( native->base.type ) )
         {
           return nullptr;
         }
@@ -364,6 +676,19 @@ namespace upywrap
       return native;
     }
 
+    //Whether t is the type of a ClassWrapper< T >, possibly registered elsewhere.
+    static bool IsWrappedType( const mp_obj_type_t* t )
+    {
+      const auto other = detail::AsClassWrapperType( t );
+      //Checked even without UPYWRAP_FULLTYPECHECK: reading obj from an instance with T inline,
+      //or vice-versa, would be reading something else entirely.
+      return other && other->cookie == defCookie && other->inlineOffset == wrapped.inlineOffset
+#if UPYWRAP_FULLTYPECHECK
+        && typeid( T ) == *other->typeId
+#endif
+        ;
+    }
+
     static ClassWrapper< T >* AsNativeObjChecked( mp_obj_t arg )
     {
       if( auto native = AsNativeObjCheckedImpl( arg ) )
@@ -389,7 +714,7 @@ namespace upywrap
         }
       }
       CheckTypeIsRegistered(); //since we want to access type.name
-      RaiseTypeException( arg, qstr_str( type.name ) );
+      RaiseTypeException( arg, qstr_str( wrapped.type.name ) );
 #if !defined( _MSC_VER ) || defined( _DEBUG )
       return nullptr;
 #endif
@@ -407,12 +732,13 @@ namespace upywrap
 
     static native_obj_t AsNativeObj( mp_obj_t arg )
     {
-      return arg == mp_const_none ? nullptr : AsNativeObjChecked( arg )->obj;
+      return arg == mp_const_none ? nullptr : AsNativeObjChecked( arg )->NativeObj( arg );
     }
 
 #if UPYWRAP_SHAREDPTROBJ
     static native_obj_t& AsNativeObjRef( mp_obj_t arg ) //in case the native side wants a reference, avoid extra ptr copies
     {
+      static_assert( !storeInline, "Types with InlineStorage have no shared_ptr to refer to, pass shared_ptr by value instead" );
       return AsNativeObjChecked( arg )->obj;
     }
 #endif
@@ -430,10 +756,10 @@ namespace upywrap
       if( !init )
       {
         OneTimeInit( name );
-        type.flags = flags;
+        wrapped.type.flags = flags;
         init = true;
       }
-      else if( type.flags != flags )
+      else if( ( wrapped.type.flags & ~iterFlags ) != flags )
       {
         RaiseTypeException( "ClassWrapper's type flags can only be set once" );
       }
@@ -445,16 +771,89 @@ namespace upywrap
       func_name_def( Exit )
     };
 
+    using inline_tag = std::integral_constant< bool, storeInline >;
+
+    template< class... A >
+    void DefaultInitImpl( Arguments arguments, std::false_type )
+    {
+      DefInit( ConstructorFactoryFunc< A... >, std::move( arguments ) );
+    }
+
+    template< class... A >
+    void DefaultInitImpl( Arguments arguments, std::true_type )
+    {
+      InitImpl< FixedFuncNames::Init, mp_obj_t( * )( A... ), mp_obj_t, A... >( InlineConstructorFunc< A... >, std::move( arguments ) );
+    }
+
+    template< class... Args >
+    static mp_obj_t InlineConstructorFunc( Args... args )
+    {
+      return NewInline( std::forward< Args >( args )... );
+    }
+
+    //Turn what the function passed to DefInit returns into an instance.
+    static mp_obj_t FromInit( mp_obj_t o )
+    {
+      return o;
+    }
+
+    static mp_obj_t FromInit( T* p )
+    {
+      return AsPyObj( native_obj_t( p ) );
+    }
+
+#if UPYWRAP_SHAREDPTROBJ
+    static mp_obj_t FromInit( native_obj_t p )
+    {
+      return AsPyObj( std::move( p ) );
+    }
+#endif
+
+    static mp_obj_t Cast( mp_obj_t other, std::false_type )
+    {
+      return AsPyObj( AsNativeObjChecked( other )->obj );
+    }
+
+    static mp_obj_t Cast( mp_obj_t other, std::true_type )
+    {
+      return NewInline( *AsNativeNonNullPtr( other ) );
+    }
+
+    //Offset of T in instances of types with InlineStorage: it takes the place of obj.
+    static constexpr std::size_t InlineOffset()
+    {
+      return ( sizeof( mp_obj_base_t ) + alignof( T ) - 1 ) / alignof( T ) * alignof( T );
+    }
+
+    T* InlinePtr()
+    {
+      return reinterpret_cast< T* >( reinterpret_cast< char* >( this ) + InlineOffset() );
+    }
+
 #if UPYWRAP_SHAREDPTROBJ
     template< class... Args >
     static std::shared_ptr< T > ConstructorFactoryFunc( Args... args )
     {
+      if( PoolSize< T >::value )
+      {
+        return std::allocate_shared< T >( PoolAllocator< T >(), std::forward< Args >( args )... );
+      }
       return std::make_shared< T >( std::forward< Args >( args )... );
     }
 
     T* GetPtr()
     {
-      return obj.get();
+      return storeInline ? InlinePtr() : obj.get();
+    }
+
+    native_obj_t NativeObj( mp_obj_t self_in )
+    {
+      if( storeInline )
+      {
+        //Nothing to share ownership of but the uPy object itself.
+        return native_obj_t( std::make_shared< PinPyObj >( self_in ), InlinePtr() );
+      }
+      return obj;
     }
 
     static void NoDelete( T* )
@@ -469,7 +868,12 @@ namespace upywrap
 
     T* GetPtr()
     {
-      return obj;
+      return storeInline ? InlinePtr() : obj;
+    }
+
+    native_obj_t NativeObj( mp_obj_t )
+    {
+      return GetPtr();
     }
 #endif
 
@@ -485,38 +889,73 @@ namespace upywrap
       virtual mp_obj_t Call( mp_obj_t self_in ) = 0;
     };
 
-    template< class Map >
-    static typename Map::mapped_type FindAttrMaybe( Map& map, qstr attr )
+    //native buffer protocol interface
+    struct NativeBufferBase
+    {
+      virtual void GetBuffer( T* p, mp_buffer_info_t* bufinfo ) = 0;
+
+      char typecode;
+      bool writable;
+    };
+
+    //native iteration interface
+    struct NativeIterBase
     {
-      auto ret = map.find( attr );
-      if( ret == map.end() )
+      virtual mp_obj_t GetIter( mp_obj_t self_in ) = 0;
+    };
+
+    //Entry in the attribute table: getter and/or setter registered for a name.
+    //Methods and class variables are not in here but only in the locals dict, since that can be modified from uPy.
+    struct NativeAttribute
+    {
+      qstr name;
+      NativeGetterCallBase* getter;
+      NativeSetterCallBase* setter;
+    };
+
+    static bool AttributeNameLess( const NativeAttribute& attribute, qstr name )
+    {
+      return attribute.name < name;
+    }
+
+    //The attribute table is sorted on qstr and only changes when registering, so lookup
+    //is a binary search in contiguous memory which finds getters and setters at once.
+    static NativeAttribute* FindAttr( qstr attr )
+    {
+      const auto it = std::lower_bound( attributes.begin(), attributes.end(), attr, AttributeNameLess );
+      if( it == attributes.end() || it->name != attr )
       {
         return nullptr;
       }
-      return ret->second;
+      return &*it;
     }
 
-    template< class Map >
-    static typename Map::mapped_type FindAttrChecked( Map& map, qstr attr )
+    static NativeAttribute& AddAttr( qstr attr )
     {
-      const auto attrValue = FindAttrMaybe( map, attr );
-      if( !attrValue )
+      auto it = std::lower_bound( attributes.begin(), attributes.end(), attr, AttributeNameLess );
+      if( it == attributes.end() || it->name != attr )
       {
-        RaiseAttributeException( type.name, attr );
+        it = attributes.insert( it, NativeAttribute{ attr, nullptr, nullptr } );
       }
-      return attrValue;
+      return *it;
     }
 
-    static mp_map_elem_t* LookupLocal( qstr attr )
+    //Find whatever is stored in the locals dict, so function or class variable, or MP_OBJ_NULL.
+    static mp_obj_t LookupLocal( qstr attr )
     {
-      auto locals_map = &( (mp_obj_dict_t*) MP_OBJ_TYPE_GET_SLOT( &type, locals_dict ) )->map;
-      return mp_map_lookup( locals_map, new_qstr( attr ), MP_MAP_LOOKUP );
+      auto locals_map = &( (mp_obj_dict_t*) MP_OBJ_TYPE_GET_SLOT( &wrapped.type, locals_dict ) )->map;
+      const auto elem = mp_map_lookup( locals_map, new_qstr( attr ), MP_MAP_LOOKUP );
+      return elem ? elem->value : MP_OBJ_NULL;
     }
 
     static bool store_attr( mp_obj_t self_in, qstr attr, mp_obj_t value )
     {
-      this_type* self = (this_type*) self_in;
-      FindAttrChecked( self->setters, attr )->Call( self, value );
+      const auto nativeAttr = FindAttr( attr );
+      if( !nativeAttr || !nativeAttr->setter )
+      {
+        RaiseAttributeException( wrapped.type.name, attr );
+      }
+      nativeAttr->setter->Call( self_in, value );
       return true;
     }
 
@@ -524,19 +963,18 @@ namespace upywrap
     {
       //uPy calls load_attr to find methods as well, so we have no choice but to go through them.
       //However if we find one, it's more performant than uPy's lookup (see mp_load_method_maybe)
-      //because we know we have a proper map with only functions so we don't need x checks
-      if( auto elem = LookupLocal( attr ) )
+      //because we know we have a proper map with only functions so we don't need x checks.
+      //The locals dict comes first so methods overridden or deleted from uPy are taken into account.
+      if( auto local = LookupLocal( attr ) )
       {
-        dest[ 0 ] = elem->value;
+        dest[ 0 ] = local;
         dest[ 1 ] = self_in;
       }
-      else
+      else if( const auto nativeAttr = FindAttr( attr ) )
       {
-        this_type* self = (this_type*) self_in;
-        const auto attrValue = FindAttrMaybe( self->getters, attr );
-        if( attrValue )
+        if( nativeAttr->getter )
         {
-          *dest = attrValue->Call( self );
+          *dest = nativeAttr->getter->Call( self_in );
         }
       }
     }
@@ -558,10 +996,14 @@ namespace upywrap
 
     static mp_obj_t binary_op( mp_binary_op_t op, mp_obj_t self_in, mp_obj_t other_in )
     {
-      //First check if the type defines the op and call it if so.
-      if( auto elem = LookupLocal( mp_binary_op_method_name[ op ] ) )
+      //First check if the op is registered with DefBinaryOp, then if the type defines the op and call it if so.
+      if( op < numBinaryOps && binaryOps[ op ] )
       {
-        mp_obj_t args[] = { elem->value, self_in, other_in };
+        return binaryOps[ op ]( self_in, other_in );
+      }
+      if( auto local = LookupLocal( mp_binary_op_method_name[ op ] ) )
+      {
+        mp_obj_t args[] = { local, self_in, other_in };
         auto res = mp_call_method_n_kw( 1, 0, args );
         if( res != MP_OBJ_NULL )
         {
@@ -579,16 +1021,61 @@ namespace upywrap
       return ToPy( self->GetPtr() == other->GetPtr() );
     }
 
+    static mp_obj_t unary_op( mp_unary_op_t op, mp_obj_t self_in )
+    {
+      if( op < numUnaryOps && unaryOps[ op ] )
+      {
+        return unaryOps[ op ]( self_in );
+      }
+      return MP_OBJ_NULL; //not supported, uPy falls back to its defaults
+    }
+
+    static mp_obj_t subscr( mp_obj_t self_in, mp_obj_t index, mp_obj_t value )
+    {
+      if( value == MP_OBJ_SENTINEL )
+      {
+        return subscrFuns.load ? subscrFuns.load( self_in, index ) : MP_OBJ_NULL;
+      }
+      if( value == MP_OBJ_NULL )
+      {
+        return subscrFuns.del ? subscrFuns.del( self_in, index ) : MP_OBJ_NULL;
+      }
+      return subscrFuns.store ? subscrFuns.store( self_in, index, value ) : MP_OBJ_NULL;
+    }
+
+    static mp_obj_t getiter( mp_obj_t self_in, mp_obj_iter_buf_t* )
+    {
+      return nativeIter->GetIter( self_in );
+    }
+
+    static mp_obj_t iternext( mp_obj_t self_in )
+    {
+      auto self = (this_type*) self_in;
+      return iterNext( *self->GetPtr() );
+    }
+
+    static mp_int_t get_buffer( mp_obj_t self_in, mp_buffer_info_t* bufinfo, mp_uint_t flags )
+    {
+      if( ( flags & MP_BUFFER_WRITE ) && !nativeBuffer->writable )
+      {
+        return 1; //not supported, uPy raises if needed
+      }
+      auto self = (this_type*) self_in;
+      nativeBuffer->GetBuffer( self->GetPtr(), bufinfo );
+      bufinfo->typecode = nativeBuffer->typecode;
+      return 0;
+    }
+
     static void instance_print( const mp_print_t* print, mp_obj_t self_in, mp_print_kind_t kind )
     {
-      auto elem = LookupLocal( ( kind == PRINT_STR ) ? MP_QSTR___str__ : MP_QSTR___repr__ );
-      if( !elem && kind == PRINT_STR )
+      auto local = LookupLocal( ( kind == PRINT_STR ) ? MP_QSTR___str__ : MP_QSTR___repr__ );
+      if( !local && kind == PRINT_STR )
       {
-        elem = LookupLocal( MP_QSTR___repr__ );  //fall back to __repr__ if __str__ not found
+        local = LookupLocal( MP_QSTR___repr__ );  //fall back to __repr__ if __str__ not found
       }
-      if( elem )
+      if( local )
       {
-        mp_obj_print_helper( print, mp_call_function_1( elem->value, self_in ), PRINT_STR );
+        mp_obj_print_helper( print, mp_call_function_1( local, self_in ), PRINT_STR );
         return;
       }
       mp_printf( print, "<%s object at %p>", mp_obj_get_type_str( self_in ), MP_OBJ_TO_PTR( self_in ) );
@@ -596,9 +1083,9 @@ namespace upywrap
 
     static mp_obj_t instance_call( mp_obj_t self_in, size_t n_args, size_t n_kw, const mp_obj_t *args )
     {
-      if( auto elem = LookupLocal( MP_QSTR___call__ ) )
+      if( auto local = LookupLocal( MP_QSTR___call__ ) )
       {
-        return mp_call_method_self_n_kw( elem->value, self_in, n_args, n_kw, args );
+        return mp_call_method_self_n_kw( local, self_in, n_args, n_kw, args );
       }
       RaiseTypeException( "object isn't callable" );
 #if !defined( _MSC_VER ) || defined( _DEBUG )
@@ -609,42 +1096,118 @@ namespace upywrap
     static mp_obj_t del( mp_obj_t self_in )
     {
       auto self = (this_type*) self_in;
-#if UPYWRAP_SHAREDPTROBJ
-      self->obj.~shared_ptr();
-#else
-      delete self->obj;
-#endif
+      self->Destroy( std::integral_constant< bool, destruction != Destruction::Immediate >() );
       return ToPyObj< void >::Convert();
     }
 
-    void OneTimeInit( const char* name )
+    void Destroy( std::false_type ) noexcept
     {
-      type.base.type = &mp_type_type;
-      type.name = static_cast< decltype( type.name ) >( qstr_from_str( name ) );
-      //The ones we use here (so make sure the other locations stay in sync!).
-      MP_OBJ_TYPE_SET_SLOT( &type, make_new, nullptr, 0 );
-      MP_OBJ_TYPE_SET_SLOT( &type, locals_dict, mp_obj_new_dict( 0 ), 1 );
-      MP_OBJ_TYPE_SET_SLOT( &type, attr, attr, 2 );
-      MP_OBJ_TYPE_SET_SLOT( &type, binary_op, binary_op, 3 );
-      MP_OBJ_TYPE_SET_SLOT( &type, call, nullptr, 5 );
-      MP_OBJ_TYPE_SET_SLOT( &type, print, instance_print, 6 );
-      //The ones we don't use, for completeness.
-      type.slot_index_unary_op = 0;
-      type.slot_index_subscr = 0;
-      type.slot_index_iter = 0;
-      type.slot_index_buffer = 0;
-      type.slot_index_protocol = 0;
-      type.slot_index_parent = 0;
-
-      AddFunctionToTable( MP_QSTR___del__, MakeFunction( del ) );
-      auto caster = mp_obj_malloc( mp_rom_obj_static_class_method_t, &mp_type_staticmethod );
-      caster->fun = MakeFunction( Cast );
-      StoreClassVariable( "Cast", MP_OBJ_FROM_PTR( caster ) );
+      if( storeInline )
+      {
+        InlinePtr()->~T();
+      }
+      else
+      {
+#if UPYWRAP_SHAREDPTROBJ
+        obj.~shared_ptr();
+#else
+        delete obj;
+#endif
+      }
+    }
+
+    //Hand the native object over to the FinalizerQueue instead. Nothing may be thrown out of a finaliser
+    //so when that fails, because there's no memory left or T's move constructor throws, destroy it right away.
+    void Destroy( std::true_type ) noexcept
+    {
+      static_assert( !( PoolSize< T >::value && destruction == Destruction::DeferredAnyThread ), "PoolSize cannot be combined with DeferredAnyThread since the pool is not thread-safe" );
+      Defer( destruction == Destruction::DeferredAnyThread, inline_tag() );
+    }
+
+    void Defer( bool anyThread, std::true_type ) noexcept
+    {
+      //The block gets freed after the finaliser so T has to move out of it.
+      const auto moved = MoveOutOfInstance();
+      InlinePtr()->~T();
+      if( moved && !detail::FinalizerQueue::Push( moved, anyThread ) )
+      {
+        delete moved;
+      }
+    }
+
+    T* MoveOutOfInstance() noexcept
+    {
+#if UPYWRAP_USE_EXCEPTIONS
+      try
+      {
+        return new( std::nothrow ) T( std::move( *InlinePtr() ) );
+      }
+      catch( ... )
+      {
+        return nullptr;
+      }
+#else
+      return new( std::nothrow ) T( std::move( *InlinePtr() ) );
+#endif
+    }
+
+    void Defer( bool anyThread, std::false_type ) noexcept
+    {
+#if UPYWRAP_SHAREDPTROBJ
+      //If this fails obj is left untouched, so the destructor call releases it.
+      const auto moved = new( std::nothrow ) native_obj_t( std::move( obj ) );
+      obj.~shared_ptr();
+      if( moved && !detail::FinalizerQueue::Push( moved, anyThread ) )
+      {
+        delete moved;
+      }
+#else
+      if( !detail::FinalizerQueue::Push( obj, anyThread ) )
+      {
+        delete obj;
+      }
+#endif
+    }
+
+    void OneTimeInit( const char* name )
+    {
+      wrapped.type.base.type = &mp_type_type;
+      wrapped.cookie = defCookie;
+      wrapped.inlineOffset = storeInline ? InlineOffset() : 0;
+#if UPYWRAP_FULLTYPECHECK
+      wrapped.typeId = &typeid( T );
+#endif
+      wrapped.type.name = static_cast< decltype( wrapped.type.name ) >( qstr_from_str( name ) );
+      //The ones we use here (so make sure the other locations stay in sync!).
+      MP_OBJ_TYPE_SET_SLOT( &wrapped.type, make_new, nullptr, 0 );
+      MP_OBJ_TYPE_SET_SLOT( &wrapped.type, locals_dict, mp_obj_new_dict( 0 ), 1 );
+      mp_obj_dict_store( MP_OBJ_TYPE_GET_SLOT( &wrapped.type, locals_dict ), new_qstr( detail::ClassWrapperTypeMarker() ), MP_OBJ_FROM_PTR( &wrapped.type ) );
+      MP_OBJ_TYPE_SET_SLOT( &wrapped.type, attr, attr, 2 );
+      MP_OBJ_TYPE_SET_SLOT( &wrapped.type, binary_op, binary_op, 3 );
+      MP_OBJ_TYPE_SET_SLOT( &wrapped.type, call, nullptr, 5 );
+      MP_OBJ_TYPE_SET_SLOT( &wrapped.type, print, instance_print, 6 );
+      //Slot 4 is unary_op, slot 7 subscr, slot 8 iter and slot 9 buffer, but these only get set when used
+      //since uPy checks for their presence.
+      wrapped.type.slot_index_unary_op = 0;
+      wrapped.type.slot_index_subscr = 0;
+      wrapped.type.slot_index_iter = 0;
+      wrapped.type.slot_index_buffer = 0;
+      //The ones we don't use, for completeness.
+      wrapped.type.slot_index_protocol = 0;
+      wrapped.type.slot_index_parent = 0;
+
+      if( needsFinaliser )
+      {
+        AddFunctionToTable( MP_QSTR___del__, MakeFunction( del ) );
+      }
+      auto caster = mp_obj_malloc( mp_rom_obj_static_class_method_t, &mp_type_staticmethod );
+      caster->fun = MakeFunction( Cast );
+      StoreClassVariable( "Cast", MP_OBJ_FROM_PTR( caster ) );
     }
 
     static void CheckTypeIsRegistered()
     {
-      if( type.base.type == nullptr )
+      if( wrapped.type.base.type == nullptr )
       {
 #if UPYWRAP_HAS_TYPEID
         std::string errorMessage( std::string( "Native type " ) + typeid( T ).name() + " has not been registered" );
@@ -657,7 +1220,7 @@ namespace upywrap
 
     void AddFunctionToTable( const qstr name, mp_obj_t fun )
     {
-      mp_obj_dict_store( MP_OBJ_TYPE_GET_SLOT( &type, locals_dict ), new_qstr( name ), fun );
+      mp_obj_dict_store( MP_OBJ_TYPE_GET_SLOT( &wrapped.type, locals_dict ), new_qstr( name ), fun );
     }
 
     void AddFunctionToTable( const char* name, mp_obj_t fun )
@@ -665,6 +1228,16 @@ namespace upywrap
       AddFunctionToTable( qstr_from_str( name ), fun );
     }
 
+    //AddFunctionToTable for Def'd functions: these can be special methods which need a slot.
+    void AddMethodToTable( const char* name, mp_obj_t fun )
+    {
+      AddFunctionToTable( name, fun );
+      if( std::string( name ) == "__call__" )
+      {
+        MP_OBJ_TYPE_SET_SLOT( &wrapped.type, call, instance_call, 5 );
+      }
+    }
+
     template< index_type name, class Ret, class Fun, class... A >
     void DefImpl( Fun f, Arguments&& arguments, typename SelectRetvalConverter< Ret >::type conv )
     {
@@ -672,12 +1245,8 @@ namespace upywrap
       auto callerObject = call_type::CreateCaller( f );
       callerObject->convert_retval = conv;
       callerObject->arguments = std::move( arguments );
-      functionPointers[ (void*) name ] = callerObject;
-      AddFunctionToTable( name(), call_type::CreateUPyFunction( *callerObject ) );
-      if( std::string( name() ) == "__call__" )
-      {
-        MP_OBJ_TYPE_SET_SLOT( &type, call, instance_call, 5 );
-      }
+      call_type::Caller() = callerObject;
+      AddMethodToTable( name(), call_type::CreateUPyFunction( *callerObject ) );
     }
 
     template< index_type name, class Ret, class Fun, class... A >
@@ -686,16 +1255,171 @@ namespace upywrap
       DefImpl< name, Ret, Fun, A... >( f, Arguments(), conv );
     }
 
+#if UPYWRAP_HAS_CPP17
+    template< index_type name, auto f, class Base, class Ret, class... A >
+    typename std::enable_if< std::is_base_of< Base, T >::value >::type DefBound( Ret ( Base::* )( A... ), Arguments&& arguments )
+    {
+      DefBoundImpl< name, BoundMemberFunctionCall< f, T, Ret, A... >, Ret, A... >( std::move( arguments ) );
+    }
+
+    template< index_type name, auto f, class Base, class Ret, class... A >
+    typename std::enable_if< std::is_base_of< Base, T >::value >::type DefBound( Ret ( Base::* )( A... ) const, Arguments&& arguments )
+    {
+      DefBoundImpl< name, BoundMemberFunctionCall< f, T, Ret, A... >, Ret, A... >( std::move( arguments ) );
+    }
+
+    template< index_type name, auto f, class Ret, class... A >
+    void DefBound( Ret ( * )( T*, A... ), Arguments&& arguments )
+    {
+      DefBoundImpl< name, BoundNonMemberFunctionCall< f, T, Ret, A... >, Ret, A... >( std::move( arguments ) );
+    }
+
+    template< index_type name, auto f, class Ret, class... A >
+    void DefBound( Ret ( * )( T&, A... ), Arguments&& arguments )
+    {
+      DefBoundImpl< name, BoundNonMemberByRefFunctionCall< f, T, Ret, A... >, Ret, A... >( std::move( arguments ) );
+    }
+
+    template< index_type name, auto f, class Ret, class... A >
+    void DefBound( Ret ( * )( const T&, A... ), Arguments&& arguments )
+    {
+      DefBoundImpl< name, BoundNonMemberByRefFunctionCall< f, T, Ret, A... >, Ret, A... >( std::move( arguments ) );
+    }
+
+    template< index_type name, class Fun, class Ret, class... A >
+    void DefBoundImpl( Arguments&& arguments )
+    {
+      typedef NativeBoundMemberCall< name, Fun, Ret, A... > call_type;
+      AddMethodToTable( name(), call_type::CreateUPyFunction( std::move( arguments ) ) );
+    }
+#endif
+
+    //Used as name for binary operators.
+    template< mp_binary_op_t op >
+    static const char* BinaryOpName()
+    {
+      return qstr_str( mp_binary_op_method_name[ op ] );
+    }
+
+    template< mp_binary_op_t op, class Ret, class Fun, class A >
+    void BinaryOpImpl( Fun f, typename SelectRetvalConverter< Ret >::type conv )
+    {
+      static_assert( op < numBinaryOps, "Operator cannot be implemented by a type" );
+      typedef NativeMemberCall< BinaryOpName< op >, Ret, A > call_type;
+      DefImpl< BinaryOpName< op >, Ret, Fun, A >( f, conv );
+      binaryOps[ op ] = call_type::Call;
+    }
+
+    //Used as name for unary operators; these are not all guaranteed to exist as qstr.
+    template< mp_unary_op_t op >
+    static const char* UnaryOpName()
+    {
+      static_assert( op != MP_UNARY_OP_NOT && op < numUnaryOps, "Unsupported unary operator" );
+      switch( op )
+      {
+        case MP_UNARY_OP_POSITIVE: return "__pos__";
+        case MP_UNARY_OP_NEGATIVE: return "__neg__";
+        case MP_UNARY_OP_INVERT: return "__invert__";
+        case MP_UNARY_OP_BOOL: return "__bool__";
+        case MP_UNARY_OP_LEN: return "__len__";
+        case MP_UNARY_OP_HASH: return "__hash__";
+        case MP_UNARY_OP_ABS: return "__abs__";
+        case MP_UNARY_OP_INT_MAYBE: return "__int__";
+        case MP_UNARY_OP_FLOAT_MAYBE: return "__float__";
+        case MP_UNARY_OP_COMPLEX_MAYBE: return "__complex__";
+        case MP_UNARY_OP_SIZEOF: return "__sizeof__";
+        default: return nullptr; //ruled out by the static_assert
+      }
+    }
+
+    template< mp_unary_op_t op, class Ret, class Fun >
+    void UnaryOpImpl( Fun f, typename SelectRetvalConverter< Ret >::type conv )
+    {
+      static_assert( op != MP_UNARY_OP_NOT, "Operator cannot be implemented by a type, use MP_UNARY_OP_BOOL" );
+      typedef NativeMemberCall< UnaryOpName< op >, Ret > call_type;
+      DefImpl< UnaryOpName< op >, Ret, Fun >( f, conv );
+      unaryOps[ op ] = op == MP_UNARY_OP_HASH ? SmallIntHash< call_type::Call > : call_type::Call;
+      MP_OBJ_TYPE_SET_SLOT( &wrapped.type, unary_op, unary_op, 4 );
+    }
+
+    //uPy's map lookups take hashes as small int without checking, so fold anything else into that range.
+    template< mp_fun_1_t call >
+    static mp_obj_t SmallIntHash( mp_obj_t self_in )
+    {
+      const auto hash = call( self_in );
+      if( mp_obj_is_small_int( hash ) )
+      {
+        return hash;
+      }
+      return MP_OBJ_NEW_SMALL_INT( mp_obj_get_int_truncated( hash ) & MP_SMALL_INT_MAX );
+    }
+
+    template< class Ret, class Fun, class A >
+    void GetItemImpl( Fun f, typename SelectRetvalConverter< Ret >::type conv )
+    {
+      typedef NativeMemberCall< special_methods::__getitem__, Ret, A > call_type;
+      DefImpl< special_methods::__getitem__, Ret, Fun, A >( f, conv );
+      subscrFuns.load = call_type::Call;
+      MP_OBJ_TYPE_SET_SLOT( &wrapped.type, subscr, subscr, 7 );
+    }
+
+    template< class Fun, class A, class V >
+    void SetItemImpl( Fun f )
+    {
+      typedef NativeMemberCall< special_methods::__setitem__, void, A, V > call_type;
+      DefImpl< special_methods::__setitem__, void, Fun, A, V >( f, nullptr );
+      subscrFuns.store = call_type::Call;
+      MP_OBJ_TYPE_SET_SLOT( &wrapped.type, subscr, subscr, 7 );
+    }
+
+    template< class Fun, class A >
+    void DelItemImpl( Fun f )
+    {
+      typedef NativeMemberCall< special_methods::__delitem__, void, A > call_type;
+      DefImpl< special_methods::__delitem__, void, Fun, A >( f, nullptr );
+      subscrFuns.del = call_type::Call;
+      MP_OBJ_TYPE_SET_SLOT( &wrapped.type, subscr, subscr, 7 );
+    }
+
+    template< class D, class DataFun, class SizeFun >
+    void BufferImpl( DataFun data, SizeFun size, char typecode, bool writable )
+    {
+      nativeBuffer = new NativeBuffer< D, DataFun, SizeFun >( data, size );
+      nativeBuffer->typecode = typecode;
+      nativeBuffer->writable = writable;
+      MP_OBJ_TYPE_SET_SLOT( &wrapped.type, buffer, get_buffer, 9 );
+    }
+
+    template< class It, class BeginFun, class EndFun >
+    void IterImpl( BeginFun begin, EndFun end )
+    {
+      nativeIter = new NativeIter< It, BeginFun, EndFun >( begin, end );
+      wrapped.type.flags &= ~iterFlags;
+      MP_OBJ_TYPE_SET_SLOT( &wrapped.type, iter, getiter, 8 );
+    }
+
+    template< class It >
+    static It StdBegin( T& p )
+    {
+      return std::begin( p );
+    }
+
+    template< class It >
+    static It StdEnd( T& p )
+    {
+      return std::end( p );
+    }
+
     template< class Fun, class A >
     void SetterImpl( const char* name, Fun f )
     {
-      setters[ qstr_from_str( name ) ] = new NativeSetterCall< A >( f );
+      AddAttr( qstr_from_str( name ) ).setter = new NativeSetterCall< A >( f );
     }
 
     template< class Fun, class A >
     void GetterImpl( const char* name, Fun f )
     {
-      getters[ qstr_from_str( name ) ] = new NativeGetterCall< A >( f );
+      AddAttr( qstr_from_str( name ) ).getter = new NativeGetterCall< A >( f );
     }
 
     template< index_type name, class Fun, class Ret, class... A >
@@ -704,8 +1428,8 @@ namespace upywrap
       typedef NativeMemberCall< name, Ret, A... > call_type;
       auto caller = call_type::CreateCaller( f );
       caller->arguments = std::move( arguments );
-      functionPointers[ (void*) name ] = caller;
-      MP_OBJ_TYPE_SET_SLOT( &type, make_new, call_type::MakeNew, 0 );
+      call_type::InitCaller() = caller;
+      MP_OBJ_TYPE_SET_SLOT( &wrapped.type, make_new, call_type::MakeNew, 0 );
     }
 
     template< index_type name, class Fun, class Ret, class... A >
@@ -718,7 +1442,7 @@ namespace upywrap
     void ExitImpl( Fun f )
     {
       typedef NativeMemberCall< name, void > call_type;
-      functionPointers[ (void*) name ] = call_type::CreateCaller( f );
+      call_type::Caller() = call_type::CreateCaller( f );
       AddFunctionToTable( MP_QSTR___enter__, (mp_obj_t) &mp_identity_obj );
       AddFunctionToTable( MP_QSTR___exit__, MakeFunction( 4, call_type::CallDiscard ) );
     }
@@ -818,6 +1542,20 @@ namespace upywrap
         return new init_call_type( f );
       }
 
+      //Each instantiation is unique for the given name and signature so it can own
+      //its caller object, which means calling doesn't require any lookup.
+      static call_type*& Caller()
+      {
+        static call_type* caller = nullptr;
+        return caller;
+      }
+
+      static init_call_type*& InitCaller()
+      {
+        static init_call_type* caller = nullptr;
+        return caller;
+      }
+
       static mp_obj_t CreateUPyFunction( const call_type& caller )
       {
         if( caller.arguments.HasArguments() )
@@ -836,13 +1574,13 @@ namespace upywrap
         assert( n_args == 4 );
         static_assert( sizeof...( A ) == 0, "Arguments must be discarded" );
         auto self = (this_type*) args[ 0 ];
-        auto f = (call_type*) this_type::functionPointers[ (void*) index ];
+        auto f = Caller();
         return CallReturn< Ret, A... >::Call( f, self->GetPtr() );
       }
 
       static mp_obj_t MakeNew( const mp_obj_type_t*, mp_uint_t n_args, mp_uint_t n_kw, const mp_obj_t* args )
       {
-        auto f = (init_call_type*) this_type::functionPointers[ (void*) index ];
+        auto f = InitCaller();
         if( f->arguments.HasArguments() )
         {
           if( f->arguments.NumberOfArguments() != sizeof...( A ) )
@@ -852,7 +1590,7 @@ namespace upywrap
           Arguments::parsed_obj_t parsedArgs{};
           f->arguments.Parse( n_args, n_kw, args, parsedArgs );
           UPYWRAP_TRY
-          return AsPyObj( native_obj_t( Apply( f, parsedArgs.data(), make_index_sequence< sizeof...( A ) >() ) ) );
+          return FromInit( Apply( f, parsedArgs.data(), make_index_sequence< sizeof...( A ) >() ) );
           UPYWRAP_CATCH
         }
         else if( n_args != sizeof...( A ) || n_kw )
@@ -860,18 +1598,18 @@ namespace upywrap
           RaiseTypeException( ( std::string( "Wrong number of arguments in definition of " ) + index() ).data() );
         }
         UPYWRAP_TRY
-        return AsPyObj( native_obj_t( Apply( f, args, make_index_sequence< sizeof...( A ) >() ) ) );
+        return FromInit( Apply( f, args, make_index_sequence< sizeof...( A ) >() ) );
         UPYWRAP_CATCH
       }
 
-    private:
       static mp_obj_t Call( mp_obj_t self_in, typename project2nd< A, mp_obj_t >::type... args )
       {
         auto self = (this_type*) self_in;
-        auto f = (call_type*) this_type::functionPointers[ (void*) index ];
+        auto f = Caller();
         return CallReturn< Ret, A... >::Call( f, self->GetPtr(), args... );
       }
 
+    private:
       static mp_obj_t CallN( mp_uint_t n_args, const mp_obj_t* args )
       {
         if( n_args != sizeof...( A ) + 1 )
@@ -880,7 +1618,7 @@ namespace upywrap
         }
         auto self = (this_type*) args[ 0 ];
         auto firstArg = &args[ 1 ];
-        auto f = (call_type*) this_type::functionPointers[ (void*) index ];
+        auto f = Caller();
         return CallVar( f, self->GetPtr(), firstArg, make_index_sequence< sizeof...( A ) >() );
       }
 
@@ -891,7 +1629,7 @@ namespace upywrap
         {
           RaiseTypeException( "Wrong number of arguments" );
         }
-        auto f = (call_type*) this_type::functionPointers[ (void*) index ];
+        auto f = Caller();
         Arguments::parsed_obj_t parsedArgs{};
         f->arguments.Parse( n_args - 1, pos_args + 1, kw_args, parsedArgs );
         auto self = (this_type*) pos_args[ 0 ];
@@ -913,56 +1651,187 @@ namespace upywrap
       }
     };
 
+#if UPYWRAP_HAS_CPP17
+    //Same as NativeMemberCall but for functions known at compile-time.
+    template< index_type index, class Fun, class Ret, class... A >
+    struct NativeBoundMemberCall
+    {
+      //Only allocated when keyword arguments are used.
+      static Arguments*& KwArguments()
+      {
+        static Arguments* arguments = nullptr;
+        return arguments;
+      }
+
+      static mp_obj_t CreateUPyFunction( Arguments&& arguments )
+      {
+        if( arguments.HasArguments() )
+        {
+          if( arguments.NumberOfArguments() != sizeof...( A ) )
+          {
+            RaiseTypeException( ( std::string( "Wrong number of arguments in definition of " ) + index() ).data() );
+          }
+          const auto minNumArgs = arguments.MimimumNumberOfArguments();
+          KwArguments() = new Arguments( std::move( arguments ) );
+          return MakeFunction( minNumArgs, CallKw );
+        }
+        return CreateFunction< mp_obj_t, A... >::Create( Call, CallN );
+      }
+
+    private:
+      static mp_obj_t Call( mp_obj_t self_in, typename project2nd< A, mp_obj_t >::type... args )
+      {
+        auto self = (this_type*) self_in;
+        return BoundCallReturn< Ret, A... >::template Call< Fun >( self->GetPtr(), args... );
+      }
+
+      static mp_obj_t CallN( mp_uint_t n_args, const mp_obj_t* args )
+      {
+        if( n_args != sizeof...( A ) + 1 )
+        {
+          RaiseTypeException( "Wrong number of arguments" );
+        }
+        auto self = (this_type*) args[ 0 ];
+        return CallVar( self->GetPtr(), &args[ 1 ], make_index_sequence< sizeof...( A ) >() );
+      }
+
+      static mp_obj_t CallKw( size_t n_args, const mp_obj_t* pos_args, mp_map_t* kw_args )
+      {
+        //Self is required.
+        if( n_args < 1 )
+        {
+          RaiseTypeException( "Wrong number of arguments" );
+        }
+        Arguments::parsed_obj_t parsedArgs{};
+        KwArguments()->Parse( n_args - 1, pos_args + 1, kw_args, parsedArgs );
+        auto self = (this_type*) pos_args[ 0 ];
+        return CallVar( self->GetPtr(), parsedArgs.data(), make_index_sequence< sizeof...( A ) >() );
+      }
+
+      template< size_t... Indices >
+      static mp_obj_t CallVar( T* self, const mp_obj_t* args, index_sequence< Indices... > )
+      {
+        (void) args;
+        return BoundCallReturn< Ret, A... >::template Call< Fun >( self, args[ Indices ]... );
+      }
+    };
+#endif
+
+    //native buffer protocol implementation
+    template< class D, class DataFun, class SizeFun >
+    struct NativeBuffer : NativeBufferBase
+    {
+      NativeBuffer( DataFun data, SizeFun size ) :
+        data( data ),
+        size( size )
+      {
+      }
+
+      void GetBuffer( T* p, mp_buffer_info_t* bufinfo )
+      {
+        bufinfo->buf = (void*) ( p->*data )();
+        bufinfo->len = static_cast< size_t >( ( p->*size )() ) * sizeof( D );
+      }
+
+    private:
+      DataFun data;
+      SizeFun size;
+    };
+
+    //native iteration implementation
+    template< class It, class BeginFun, class EndFun >
+    struct NativeIter : NativeIterBase
+    {
+      NativeIter( BeginFun begin, EndFun end ) :
+        begin( begin ),
+        end( end )
+      {
+      }
+
+      mp_obj_t GetIter( mp_obj_t self_in )
+      {
+        auto self = (this_type*) self_in;
+        auto& p = *self->GetPtr();
+        return detail::NativeIterator< T, It >::Create( self_in, Call( begin, p ), Call( end, p ) );
+      }
+
+    private:
+      template< class Fun >
+      static It Call( Fun f, T& p, typename std::enable_if< std::is_member_function_pointer< Fun >::value >::type* = nullptr )
+      {
+        return ( p.*f )();
+      }
+
+      template< class Fun >
+      static It Call( Fun f, T& p, typename std::enable_if< !std::is_member_function_pointer< Fun >::value >::type* = nullptr )
+      {
+        return f( p );
+      }
+
+      BeginFun begin;
+      EndFun end;
+    };
+
+    //Native functions for the subscr slot, see DefGetItem etc.
+    struct SubscrFunctions
+    {
+      mp_fun_2_t load;
+      mp_fun_3_t store;
+      mp_fun_2_t del;
+    };
+
     typedef ClassWrapper< T > this_type;
-    using store_attr_map = std::map< qstr, NativeSetterCallBase* >;
-    using load_attr_map = std::map< qstr, NativeGetterCallBase* >;
+    using attribute_table = std::vector< NativeAttribute >;
+    static constexpr int numBinaryOps = MP_BINARY_OP_NUM_RUNTIME;
+    static constexpr int numUnaryOps = MP_UNARY_OP_SIZEOF + 1; //there's no MP_UNARY_OP_NUM_RUNTIME, this is the last one
+    //Set by DefIterNext instead of passed to the constructor.
+    static constexpr decltype( mp_obj_type_t::flags ) iterFlags = MP_TYPE_FLAG_ITER_IS_ITERNEXT;
 
+    //Instances are just the base and the native object, or for InlineStorage the base and T itself.
     mp_obj_base_t base; //must always be the first member!
-    std::int64_t cookie; //we'll use this to check if a pointer really points to a ClassWrapper
-    const std::type_info* typeId; //and this will be used to check if types aren't being mixed
     native_obj_t obj;
-    static mp_obj_full_type_t type;
-    static function_ptrs functionPointers;
-    static store_attr_map setters;
-    static load_attr_map getters;
+    static detail::ClassWrapperType wrapped;
+    static attribute_table attributes;
+    static mp_fun_2_t binaryOps[ numBinaryOps ];
+    static mp_fun_1_t unaryOps[ numUnaryOps ];
+    static SubscrFunctions subscrFuns;
+    static NativeBufferBase* nativeBuffer;
+    static NativeIterBase* nativeIter;
+    static mp_obj_t( *iterNext )( T& );
     static const std::int64_t defCookie;
   };
 
   template< class T >
-  mp_obj_full_type_t ClassWrapper< T >::type =
+  detail::ClassWrapperType ClassWrapper< T >::wrapped =
 #ifdef __GNUC__
-    { { nullptr } }; //GCC bug 53119
+    { { { nullptr } } }; //GCC bug 53119
 #else
-    { nullptr };
+    { { nullptr } };
 #endif
 
   template< class T >
-  function_ptrs ClassWrapper< T >::functionPointers;
+  typename ClassWrapper< T >::attribute_table ClassWrapper< T >::attributes;
 
   template< class T >
-  typename ClassWrapper< T >::store_attr_map ClassWrapper< T >::setters;
+  mp_fun_2_t ClassWrapper< T >::binaryOps[ ClassWrapper< T >::numBinaryOps ] = {};
 
   template< class T >
-  typename ClassWrapper< T >::load_attr_map ClassWrapper< T >::getters;
+  mp_fun_1_t ClassWrapper< T >::unaryOps[ ClassWrapper< T >::numUnaryOps ] = {};
 
   template< class T >
-  const std::int64_t ClassWrapper< T >::defCookie = 0x12345678908765;
+  typename ClassWrapper< T >::SubscrFunctions ClassWrapper< T >::subscrFuns = {};
 
+  template< class T >
+  typename ClassWrapper< T >::NativeBufferBase* ClassWrapper< T >::nativeBuffer = nullptr;
 
-  /**
-    * Declare a bunch of common special method names.
-    */
-  struct special_methods
-  {
-    func_name_def( __str__ )
-    func_name_def( __repr__ )
-    func_name_def( __bytes__ )
-    func_name_def( __format__ )
-    func_name_def( __iter__ )
-    func_name_def( __next__ )
-    func_name_def( __reversed__ )
-    func_name_def( __call__ )
-  };
+  template< class T >
+  typename ClassWrapper< T >::NativeIterBase* ClassWrapper< T >::nativeIter = nullptr;
+
+  template< class T >
+  mp_obj_t( *ClassWrapper< T >::iterNext )( T& ) = nullptr;
+
+  template< class T >
+  const std::int64_t ClassWrapper< T >::defCookie = 0x12345678908765;
 
 
   template< class T >
@@ -1030,11 +1899,26 @@ namespace upywrap
   template< class T >
   struct ClassToPyObj
   {
-    static mp_obj_t Convert( T )
+    static mp_obj_t Convert( T p )
     {
-      static_assert( False< T >::value, "Conversion from value to ClassWrapper is not allowed, pass a reference or shared_ptr instead" );
-      return mp_const_none;
+      static_assert( InlineStorage< T >::value || ( UPYWRAP_SHAREDPTROBJ && PoolSize< T >::value ),
+        "Conversion from value to ClassWrapper is only allowed for types with InlineStorage or PoolSize, pass a reference or shared_ptr instead" );
+      return Convert( std::move( p ), std::integral_constant< bool, InlineStorage< T >::value >() );
+    }
+
+  private:
+    static mp_obj_t Convert( T p, std::true_type )
+    {
+      return ClassWrapper< T >::NewInline( std::move( p ) );
     }
+
+#if UPYWRAP_SHAREDPTROBJ
+    //Pooled types: move into memory from the pool, so no allocation once the pool is filled.
+    static mp_obj_t Convert( T p, std::false_type )
+    {
+      return ClassWrapper< T >::AsPyObj( std::allocate_shared< T >( PoolAllocator< T >(), std::move( p ) ) );
+    }
+#endif
   };
 
   template< class T >
@@ -1063,8 +1947,19 @@ namespace upywrap
       {
         return mp_const_none;
       }
+      return Convert( std::move( p ), std::integral_constant< bool, InlineStorage< T >::value >() );
+    }
+
+  private:
+    static mp_obj_t Convert( std::shared_ptr< T > p, std::false_type )
+    {
       return ClassWrapper< T >::AsPyObj( std::move( p ) );
     }
+
+    static mp_obj_t Convert( std::shared_ptr< T > p, std::true_type )
+    {
+      return ClassWrapper< T >::NewInline( *p );
+    }
   };
 #endif
 
@@ -1085,8 +1980,19 @@ namespace upywrap
     {
       //Make sure ClassToPyObj< std::shared_ptr< T > > gets used instead.
       static_assert( !is_shared_ptr< T >::value, "cannot convert object to shared_ptr&" );
+      return Convert( p, std::integral_constant< bool, InlineStorage< T >::value >() );
+    }
+
+  private:
+    static mp_obj_t Convert( T& p, std::false_type )
+    {
       return ClassWrapper< T >::AsPyObj( &p, false );
     }
+
+    static mp_obj_t Convert( T& p, std::true_type )
+    {
+      return ClassWrapper< T >::NewInline( p );
+    }
   };
 
   //Convert std::function into a callable.
@@ -1124,6 +2030,405 @@ namespace upywrap
   };
 }
 
+namespace upywrap
+{
+  namespace detail
+  {
+    //The iterator object created for ClassWrapper::DefIter, stored inline in its instance. That keeps
+    //the owner alive by just referring to it since the garbage collector scans the whole instance.
+    template< class T, class It >
+    struct NativeIterator
+    {
+      NativeIterator( mp_obj_t owner, It current, It end ) :
+        owner( owner ),
+        current( std::move( current ) ),
+        end( std::move( end ) )
+      {
+      }
+
+      static mp_obj_t Create( mp_obj_t owner, It current, It end )
+      {
+        using wrapper_t = ClassWrapper< NativeIterator >;
+        //Note: registered once, stays forever, like for std::function.
+        static wrapper_t reg( "iterator", wrapper_t::ConstructorOptions::RegisterInStaticPyObjectStore );
+        static bool init = false;
+        if( !init )
+        {
+          reg.DefIterNext( &Next );
+          init = true;
+        }
+        return wrapper_t::NewInline( owner, std::move( current ), std::move( end ) );
+      }
+
+      static mp_obj_t Next( NativeIterator& it )
+      {
+        if( it.current == it.end )
+        {
+          return MP_OBJ_STOP_ITERATION;
+        }
+        const auto item = SelectToPyObj< typename std::decay< decltype( *it.current ) >::type >::type::Convert( *it.current );
+        ++it.current;
+        return item;
+      }
+
+      mp_obj_t owner;
+      It current;
+      It end;
+    };
+  }
+
+  template< class T, class It >
+  struct InlineStorage< detail::NativeIterator< T, It > > : std::true_type
+  {
+  };
+
+  //Return type wrapper for handing large vectors of numbers to uPy without copying them: the vector is
+  //moved into a ClassWrapper instance exposing the data through the buffer protocol (so use memoryview,
+  //array functions etc to access it) which frees it once the instance gets garbage collected.
+  template< class Vec >
+  struct OwnedBuffer
+  {
+    OwnedBuffer( Vec value ) :
+      value( std::move( value ) )
+    {
+    }
+
+    typename Vec::value_type* Data()
+    {
+      return value.data();
+    }
+
+    std::size_t Size() const
+    {
+      return value.size();
+    }
+
+    Vec value;
+  };
+
+  template< class T, class Alloc >
+  struct ToPyObj< OwnedBuffer< std::vector< T, Alloc > > > : std::true_type
+  {
+    using buffer_t = OwnedBuffer< std::vector< T, Alloc > >;
+    using wrapper_t = ClassWrapper< buffer_t >;
+
+    //By value: a returned OwnedBuffer gets moved in here, anything else is copied, never emptied.
+    static mp_obj_t Convert( buffer_t a )
+    {
+      InitWrapper();
+      return wrapper_t::AsPyObj( new buffer_t( std::move( a ) ), true );
+    }
+
+    static void InitWrapper()
+    {
+      //Note: registered once, stays forever, like for std::function.
+      static wrapper_t reg( "OwnedBuffer", wrapper_t::ConstructorOptions::RegisterInStaticPyObjectStore );
+      static bool init = false;
+      if( !init )
+      {
+        reg.DefBuffer( &buffer_t::Data, &buffer_t::Size );
+        reg.template DefUnaryOp< MP_UNARY_OP_LEN >( &buffer_t::Size );
+        init = true;
+      }
+    }
+  };
+
+  //Return type wrapper for handing a native container to uPy without converting it: the uPy object
+  //is a read-only proxy which only converts the items which actually get accessed, so this is meant for
+  //large containers of which scripts typically only inspect a part. Sequences (std::vector etc) support
+  //len(), indexing including slices, (native) iteration and 'in'. Maps (std::map etc) support len(), indexing
+  //by key, 'in', keys() and iteration over the keys. The view shares ownership of the container so it stays valid as long as
+  //the proxy is alive, and the container must not be modified during that time.
+  //For a container which is a member of a ClassWrapper object use the aliasing constructor:
+  //
+  //struct SomeClass : std::enable_shared_from_this< SomeClass >
+  //{
+  //  ContainerView< std::vector< int > > Values()
+  //  {
+  //    return ContainerView< std::vector< int > >( shared_from_this(), values );
+  //  }
+  //
+  //  std::vector< int > values;
+  //};
+  //
+  //Note this requires UPYWRAP_SHAREDPTROBJ, else shared_from_this() doesn't work for ClassWrapper objects.
+  template< class Container >
+  class ContainerView
+  {
+  public:
+    using container_type = Container;
+
+    ContainerView( std::shared_ptr< const Container > container ) :
+      container( std::move( container ) )
+    {
+    }
+
+    template< class Owner >
+    ContainerView( const std::shared_ptr< Owner >& owner, const Container& container ) :
+      container( owner, &container )
+    {
+    }
+
+    const Container& Get() const
+    {
+      return *container;
+    }
+
+    std::size_t Size() const
+    {
+      return container->size();
+    }
+
+    typename Container::const_iterator begin() const
+    {
+      return container->cbegin();
+    }
+
+    typename Container::const_iterator end() const
+    {
+      return container->cend();
+    }
+
+  private:
+    std::shared_ptr< const Container > container;
+  };
+
+  namespace detail
+  {
+    template< class T, class = void >
+    struct IsMapLike : std::false_type
+    {
+    };
+
+    template< class T >
+    struct IsMapLike< T, typename std::conditional< false, typename T::mapped_type, void >::type > : std::true_type
+    {
+    };
+
+    struct ContainerViewFuncs
+    {
+      func_name_def( keys )
+    };
+
+    template< class Container, bool isMap = IsMapLike< Container >::value >
+    struct ContainerViewAccess
+    {
+      using view_t = ContainerView< Container >;
+
+      static mp_obj_t ConvertItem( const Container& c, mp_int_t index )
+      {
+        return SelectToPyObj< typename Container::value_type >::type::Convert( *std::next( c.cbegin(), index ) );
+      }
+
+      //Convert a slice walking the container once, from its lowest index on, so it's linear also for
+      //containers without random access. Negative steps fill the list back to front.
+      static void ConvertItems( const Container& c, const mp_bound_slice_t& slice, mp_int_t numItems, mp_obj_t* items )
+      {
+        if( !numItems )
+        {
+          return;
+        }
+        const auto stride = slice.step > 0 ? slice.step : -slice.step;
+        auto it = std::next( c.cbegin(), slice.step > 0 ? slice.start : slice.start + ( numItems - 1 ) * slice.step );
+        for( mp_int_t i = 0 ; i < numItems ; ++i )
+        {
+          if( i )
+          {
+            std::advance( it, stride );
+          }
+          items[ slice.step > 0 ? i : numItems - 1 - i ] = SelectToPyObj< typename Container::value_type >::type::Convert( *it );
+        }
+      }
+
+      static mp_obj_t GetItem( const view_t& view, mp_obj_t index )
+      {
+        const auto& c = view.Get();
+        if( mp_obj_is_type( index, &mp_type_slice ) )
+        {
+          mp_bound_slice_t slice;
+          mp_obj_slice_indices( index, static_cast< mp_int_t >( c.size() ), &slice );
+          const auto numItems = slice.step > 0 ?
+            ( slice.stop > slice.start ? ( slice.stop - slice.start + slice.step - 1 ) / slice.step : 0 ) :
+            ( slice.start > slice.stop ? ( slice.start - slice.stop - slice.step - 1 ) / -slice.step : 0 );
+          auto list = reinterpret_cast< mp_obj_list_t* >( MP_OBJ_TO_PTR( mp_obj_new_list( numItems, nullptr ) ) );
+          ConvertItems( c, slice, numItems, list->items );
+          return MP_OBJ_FROM_PTR( list );
+        }
+        //Raises IndexError when out of range.
+        return ConvertItem( c, static_cast< mp_int_t >( mp_get_index( &mp_type_list, c.size(), index, false ) ) );
+      }
+
+      template< class Wrapper >
+      static void Register( Wrapper& reg )
+      {
+        reg.DefGetItem( &GetItem );
+        reg.DefIter();
+      }
+    };
+
+    //Iterator over the keys of a map, so iterating a map view yields keys like iterating a dict does.
+    template< class Container >
+    struct KeyIterator
+    {
+      const typename Container::key_type& operator * () const
+      {
+        return it->first;
+      }
+
+      KeyIterator& operator ++ ()
+      {
+        ++it;
+        return *this;
+      }
+
+      bool operator == ( const KeyIterator& rh ) const
+      {
+        return it == rh.it;
+      }
+
+      bool operator != ( const KeyIterator& rh ) const
+      {
+        return it != rh.it;
+      }
+
+      typename Container::const_iterator it;
+    };
+
+    template< class Container >
+    struct ContainerViewAccess< Container, true >
+    {
+      using view_t = ContainerView< Container >;
+      using key_type = typename Container::key_type;
+      using key_iterator = KeyIterator< Container >;
+
+      static key_iterator KeysBegin( const view_t& view )
+      {
+        return key_iterator{ view.Get().cbegin() };
+      }
+
+      static key_iterator KeysEnd( const view_t& view )
+      {
+        return key_iterator{ view.Get().cend() };
+      }
+
+      //Raises KeyError for keys which are not in the map, and the conversion error (usually TypeError)
+      //for keys which cannot be converted to key_type.
+      static mp_obj_t GetItem( const view_t& view, mp_obj_t key )
+      {
+        const auto& c = view.Get();
+        const auto it = c.find( SelectFromPyObj< key_type >::type::Convert( key ) );
+        if( it == c.cend() )
+        {
+          nlr_raise( mp_obj_new_exception_arg1( &mp_type_KeyError, key ) );
+        }
+        return SelectToPyObj< typename Container::mapped_type >::type::Convert( it->second );
+      }
+
+      //Like for a dict, a key of the wrong type simply isn't in the map: TypeError from converting it
+      //means False, any other exception is passed on.
+      static bool Contains( const view_t& view, mp_obj_t key )
+      {
+        const auto& c = view.Get();
+        bool found = false;
+        WrapMicroPythonCall( [&] () { found = c.find( SelectFromPyObj< key_type >::type::Convert( key ) ) != c.cend(); },
+                             [] ( void* ex )
+        {
+          if( !mp_obj_exception_match( MP_OBJ_FROM_PTR( ex ), MP_OBJ_FROM_PTR( &mp_type_TypeError ) ) )
+          {
+            nlr_jump( ex );
+          }
+        } );
+        return found;
+      }
+
+      static mp_obj_t Keys( const view_t& view )
+      {
+        const auto& c = view.Get();
+        auto list = reinterpret_cast< mp_obj_list_t* >( MP_OBJ_TO_PTR( mp_obj_new_list( c.size(), nullptr ) ) );
+        std::transform( c.cbegin(), c.cend(), list->items, [] ( const typename Container::value_type& item )
+        {
+          return SelectToPyObj< key_type >::type::Convert( item.first );
+        } );
+        return MP_OBJ_FROM_PTR( list );
+      }
+
+      template< class Wrapper >
+      static void Register( Wrapper& reg )
+      {
+        reg.DefGetItem( &GetItem );
+        reg.template DefBinaryOp< MP_BINARY_OP_CONTAINS >( &Contains );
+        reg.template Def< ContainerViewFuncs::keys >( &Keys );
+        reg.DefIter( &KeysBegin, &KeysEnd );
+      }
+    };
+  }
+
+  template< class Container >
+  struct ToPyObj< ContainerView< Container > > : std::true_type
+  {
+    using view_t = ContainerView< Container >;
+    using wrapper_t = ClassWrapper< view_t >;
+
+    static mp_obj_t Convert( const view_t& a )
+    {
+      InitWrapper();
+      return wrapper_t::AsPyObj( new view_t( a ), true );
+    }
+
+    static void InitWrapper()
+    {
+      //Note: registered once, stays forever, like for std::function.
+      static wrapper_t reg( "ContainerView", wrapper_t::ConstructorOptions::RegisterInStaticPyObjectStore );
+      static bool init = false;
+      if( !init )
+      {
+        reg.template DefUnaryOp< MP_UNARY_OP_LEN >( &view_t::Size );
+        detail::ContainerViewAccess< Container >::Register( reg );
+        init = true;
+      }
+    }
+  };
+
+#if UPYWRAP_HAS_COROUTINES
+  template< class T >
+  struct ToPyObj< Generator< T > > : std::true_type
+  {
+    using generator_t = Generator< T >;
+    using wrapper_t = ClassWrapper< generator_t >;
+
+    //Generator is move-only so this only accepts temporaries, i.e. returned generators.
+    static mp_obj_t Convert( generator_t a )
+    {
+      InitWrapper();
+      return wrapper_t::AsPyObj( new generator_t( std::move( a ) ), true );
+    }
+
+    static mp_obj_t Next( generator_t& generator )
+    {
+      UPYWRAP_TRY
+      if( const auto value = generator.Next() )
+      {
+        return SelectToPyObj< T >::type::Convert( *value );
+      }
+      return MP_OBJ_STOP_ITERATION;
+      UPYWRAP_CATCH
+    }
+
+    static void InitWrapper()
+    {
+      //Note: registered once, stays forever, like for std::function.
+      static wrapper_t reg( "Generator", wrapper_t::ConstructorOptions::RegisterInStaticPyObjectStore );
+      static bool init = false;
+      if( !init )
+      {
+        reg.DefIterNext( &Next );
+        init = true;
+      }
+    }
+  };
+#endif
+}
+
 //In order for native instances to be returned to uPy, they must have been registered.
 //However sometimes you just want to return a native instance to another module without
 //defining any class methods for use in uPy, then use this macro to quickly register the class.
@@ -0,0 +1,120 @@
+#ifndef MICROPYTHON_WRAP_DETAIL_BUFFER_H
+#define MICROPYTHON_WRAP_DETAIL_BUFFER_H
+
+#include "micropython.h"
+#include <cstddef>
+#include <type_traits>
+
+namespace upywrap
+{
+  //Typecode as used by uPy's array/struct modules and the buffer protocol for a native arithmetic type.
+  template< class T, class Enable = void >
+  struct BufferTypeCode;
+
+  template< class T >
+  struct BufferTypeCode< T, typename std::enable_if< std::is_integral< T >::value && !std::is_same< T, bool >::value >::type >
+  {
+    static const char value = sizeof( T ) == 1 ? ( std::is_signed< T >::value ? 'b' : 'B' ) :
+                              sizeof( T ) == 2 ? ( std::is_signed< T >::value ? 'h' : 'H' ) :
+                              sizeof( T ) == 4 ? ( std::is_signed< T >::value ? 'i' : 'I' ) :
+                                                 ( std::is_signed< T >::value ? 'q' : 'Q' );
+  };
+
+  template<>
+  struct BufferTypeCode< float >
+  {
+    static const char value = 'f';
+  };
+
+  template<>
+  struct BufferTypeCode< double >
+  {
+    static const char value = 'd';
+  };
+
+  namespace detail
+  {
+    template< class T, class U >
+    bool SameBufferItem()
+    {
+      return sizeof( T ) == sizeof( U ) && std::is_integral< T >::value == std::is_integral< U >::value &&
+             std::is_signed< T >::value == std::is_signed< U >::value;
+    }
+  }
+
+  //Whether items of a buffer with the given typecode have the same representation as T,
+  //in which case they can be copied as-is.
+  //Note bytearray (and memoryview of it) uses a typecode of its own for what are just unsigned bytes.
+  template< class T >
+  bool IsBufferTypeCodeOf( int typecode )
+  {
+    switch( typecode )
+    {
+      case 'b': return detail::SameBufferItem< T, signed char >();
+      case 'B':
+      case BYTEARRAY_TYPECODE: return detail::SameBufferItem< T, unsigned char >();
+      case 'h': return detail::SameBufferItem< T, short >();
+      case 'H': return detail::SameBufferItem< T, unsigned short >();
+      case 'i': return detail::SameBufferItem< T, int >();
+      case 'I': return detail::SameBufferItem< T, unsigned int >();
+      case 'l': return detail::SameBufferItem< T, long >();
+      case 'L': return detail::SameBufferItem< T, unsigned long >();
+      case 'q': return detail::SameBufferItem< T, long long >();
+      case 'Q': return detail::SameBufferItem< T, unsigned long long >();
+      case 'f': return detail::SameBufferItem< T, float >();
+      case 'd': return detail::SameBufferItem< T, double >();
+      default: return false;
+    }
+  }
+
+  //Contiguous memory of a uPy object supporting the buffer protocol, used as function argument
+  //to access e.g. bytearray or array items directly. Use BufferView< const T > for read-only access.
+  //Since the memory is owned by the uPy object the view is only valid during the native call.
+  //With C++20 std::span can be used instead.
+  template< class T >
+  class BufferView
+  {
+  public:
+    BufferView( T* data, std::size_t size ) :
+      ptr( data ),
+      len( size )
+    {
+    }
+
+    T* data() const
+    {
+      return ptr;
+    }
+
+    std::size_t size() const
+    {
+      return len;
+    }
+
+    bool empty() const
+    {
+      return len == 0;
+    }
+
+    T* begin() const
+    {
+      return ptr;
+    }
+
+    T* end() const
+    {
+      return ptr + len;
+    }
+
+    T& operator [] ( std::size_t i ) const
+    {
+      return ptr[ i ];
+    }
+
+  private:
+    T* ptr;
+    std::size_t len;
+  };
+}
+
+#endif //#ifndef MICROPYTHON_WRAP_DETAIL_BUFFER_H
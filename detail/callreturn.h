@@ -20,31 +20,36 @@ namespace upywrap
 
   //Convert arguments, call native function and return converted return value - handles void properly
   //First arg is always InstanceFunctionCall or FunctionCall, and if it's convert_retval is not nullptr
-  //it will be used instead of the default return value conversion
+  //it will be used instead of the default return value conversion.
+  //The arena outlives the argument temporaries, see UPYWRAP_SCRATCHARENA.
   template< class Ret, class... A >
   struct CallReturn
   {
     template< class Fun >
     static mp_obj_t Call( Fun f, typename project2nd< A, mp_obj_t >::type... args )
     {
+      SelectScratchArena< A... > arena;
+      (void) arena;
       UPYWRAP_TRY
       if( f->convert_retval )
       {
-        return f->convert_retval( f->Call( FromPy< A >( args )... ) );
+        return f->convert_retval( f->Call( FromPy< A >( args, arena )... ) );
       }
-      return ToPy( f->Call( FromPy< A >( args )... ) );
+      return ToPy( f->Call( FromPy< A >( args, arena )... ) );
       UPYWRAP_CATCH
     }
 
     template< class Fun, class Self >
     static mp_obj_t Call( Fun f, Self self, typename project2nd< A, mp_obj_t >::type... args )
     {
+      SelectScratchArena< A... > arena;
+      (void) arena;
       UPYWRAP_TRY
       if( f->convert_retval )
       {
-        return f->convert_retval( f->Call( self, FromPy< A >( args )... ) );
+        return f->convert_retval( f->Call( self, FromPy< A >( args, arena )... ) );
       }
-      return ToPy( f->Call( self, FromPy< A >( args )... ) );
+      return ToPy( f->Call( self, FromPy< A >( args, arena )... ) );
       UPYWRAP_CATCH
     }
   };
@@ -55,8 +60,10 @@ namespace upywrap
     template< class Fun >
     static mp_obj_t Call( Fun f, typename project2nd< A, mp_obj_t >::type... args )
     {
+      SelectScratchArena< A... > arena;
+      (void) arena;
       UPYWRAP_TRY
-      f->Call( FromPy< A >( args )... );
+      f->Call( FromPy< A >( args, arena )... );
       return ToPyObj< void >::Convert();
       UPYWRAP_CATCH
     }
@@ -64,8 +71,62 @@ namespace upywrap
     template< class Fun, class Self >
     static mp_obj_t Call( Fun f, Self self, typename project2nd< A, mp_obj_t >::type... args )
     {
+      SelectScratchArena< A... > arena;
+      (void) arena;
       UPYWRAP_TRY
-      f->Call( self, FromPy< A >( args )... );
+      f->Call( self, FromPy< A >( args, arena )... );
+      return ToPyObj< void >::Convert();
+      UPYWRAP_CATCH
+    }
+  };
+
+  //Same as CallReturn but for function objects with a static Call function, i.e. the BoundXXXCall ones:
+  //there's no object to pass and no return value converter to check.
+  template< class Ret, class... A >
+  struct BoundCallReturn
+  {
+    template< class Fun >
+    static mp_obj_t Call( typename project2nd< A, mp_obj_t >::type... args )
+    {
+      SelectScratchArena< A... > arena;
+      (void) arena;
+      UPYWRAP_TRY
+      return ToPy( Fun::Call( FromPy< A >( args, arena )... ) );
+      UPYWRAP_CATCH
+    }
+
+    template< class Fun, class Self >
+    static mp_obj_t Call( Self self, typename project2nd< A, mp_obj_t >::type... args )
+    {
+      SelectScratchArena< A... > arena;
+      (void) arena;
+      UPYWRAP_TRY
+      return ToPy( Fun::Call( self, FromPy< A >( args, arena )... ) );
+      UPYWRAP_CATCH
+    }
+  };
+
+  template< class... A >
+  struct BoundCallReturn< void, A... >
+  {
+    template< class Fun >
+    static mp_obj_t Call( typename project2nd< A, mp_obj_t >::type... args )
+    {
+      SelectScratchArena< A... > arena;
+      (void) arena;
+      UPYWRAP_TRY
+      Fun::Call( FromPy< A >( args, arena )... );
+      return ToPyObj< void >::Convert();
+      UPYWRAP_CATCH
+    }
+
+    template< class Fun, class Self >
+    static mp_obj_t Call( Self self, typename project2nd< A, mp_obj_t >::type... args )
+    {
+      SelectScratchArena< A... > arena;
+      (void) arena;
+      UPYWRAP_TRY
+      Fun::Call( self, FromPy< A >( args, arena )... );
       return ToPyObj< void >::Convert();
       UPYWRAP_CATCH
     }
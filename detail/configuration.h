@@ -21,6 +21,33 @@
 #endif
 #endif
 
+//Whether C++20 coroutines are available, for upywrap::Generator.
+#ifndef UPYWRAP_HAS_COROUTINES
+#if UPYWRAP_HAS_CPP20 && defined( __cpp_impl_coroutine )
+#define UPYWRAP_HAS_COROUTINES (1)
+#else
+#define UPYWRAP_HAS_COROUTINES (0)
+#endif
+#endif
+
+//Whether std::pmr (polymorphic allocators and memory resources) is available.
+#ifndef UPYWRAP_HAS_PMR
+#if UPYWRAP_HAS_CPP17 && defined( __has_include )
+#if __has_include( <memory_resource> )
+#define UPYWRAP_HAS_PMR (1)
+#endif
+#endif
+#endif
+#ifndef UPYWRAP_HAS_PMR
+#define UPYWRAP_HAS_PMR (0)
+#endif
+
+//Whether std::thread and std::mutex can be used, for destroying objects on a FinalizerThread.
+//Default is off since not all toolchains for microcontrollers provide them.
+#ifndef UPYWRAP_HAS_THREADS
+#define UPYWRAP_HAS_THREADS (0)
+#endif
+
 //Whether typeid can be used to get compile-time type information.
 //Also see UPYWRAP_FULLTYPECHECK.
 #ifndef UPYWRAP_HAS_TYPEID
@@ -127,4 +154,20 @@
 #define UPYWRAP_MAXNUMKWARGS (8)
 #endif
 
+//Whether arguments of container types using std::pmr::polymorphic_allocator (e.g. std::pmr::vector) get
+//their memory from a monotonic arena which lives for the duration of the native call, instead of from the
+//default memory resource. This means all of it is released in one go after the call, instead of
+//allocating and freeing every container and item separately. It also means such arguments must not
+//outlive the call, e.g. by moving them into a member. The arena starts out with a buffer of
+//UPYWRAP_SCRATCHARENASIZE bytes on the stack and only allocates when that is exhausted.
+#ifndef UPYWRAP_SCRATCHARENA
+#define UPYWRAP_SCRATCHARENA (0)
+#endif
+#ifndef UPYWRAP_SCRATCHARENASIZE
+#define UPYWRAP_SCRATCHARENASIZE (512)
+#endif
+#if UPYWRAP_SCRATCHARENA && !UPYWRAP_HAS_PMR
+#error "UPYWRAP_SCRATCHARENA requires std::pmr support"
+#endif
+
 #endif
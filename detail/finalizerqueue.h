@@ -0,0 +1,226 @@
+#ifndef MICROPYTHON_WRAP_DETAIL_FINALIZERQUEUE_H
+#define MICROPYTHON_WRAP_DETAIL_FINALIZERQUEUE_H
+
+#include "configuration.h"
+#include <cstddef>
+#include <deque>
+#include <limits>
+#include <type_traits>
+#if UPYWRAP_HAS_THREADS
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+namespace upywrap
+{
+  //When ClassWrapper< T > destroys the native object of an instance which got garbage collected.
+  enum class Destruction
+  {
+    Immediate, //in the finaliser, so during gc.collect() or whichever allocation triggered collection
+    Deferred, //moved into a queue by the finaliser, destroyed by DrainFinalizers
+    DeferredAnyThread //same, but the object may also be destroyed by a FinalizerThread
+  };
+
+  //Specialize this for types with expensive destructors (closing files, joining threads, freeing large buffers)
+  //to keep those out of the garbage collector's sweep, which then only has to move the object into a queue:
+  //
+  //template<>
+  //struct DestructionMode< Logger > : std::integral_constant< Destruction, Destruction::Deferred >
+  //{
+  //};
+  //
+  //The application is then responsible for calling DrainFinalizers regularly, e.g. in its main loop after
+  //the time critical part, and at least once before shutting down since pending objects are never destroyed
+  //otherwise. Destruction::DeferredAnyThread is only for types which are safe to destroy on another thread:
+  //it allows a FinalizerThread to take care of it.
+  template< class T >
+  struct DestructionMode : std::integral_constant< Destruction, Destruction::Immediate >
+  {
+  };
+
+  namespace detail
+  {
+    //Objects waiting to be destroyed.
+    class FinalizerQueue
+    {
+    public:
+      //Called from finalisers so must not throw: returns false if p could not be queued,
+      //in which case the caller still owns it.
+      template< class T >
+      static bool Push( T* p, bool anyThread ) noexcept
+      {
+#if UPYWRAP_USE_EXCEPTIONS
+        try
+        {
+#endif
+          auto& q = Instance();
+          Lock lock( q );
+          ( anyThread ? q.anyThread : q.mainThread ).push_back( Entry{ p, &Delete< T > } );
+#if UPYWRAP_HAS_THREADS
+          if( anyThread )
+          {
+            q.pushed.notify_one();
+          }
+#endif
+#if UPYWRAP_USE_EXCEPTIONS
+        }
+        catch( ... )
+        {
+          return false;
+        }
+#endif
+        return true;
+      }
+
+      //Destroy up to budget objects, oldest first, and return how many are still pending.
+      static std::size_t Drain( std::size_t budget )
+      {
+        auto& q = Instance();
+        for( ; budget ; --budget )
+        {
+          Entry entry;
+          {
+            Lock lock( q );
+            auto& from = q.mainThread.empty() ? q.anyThread : q.mainThread;
+            if( from.empty() )
+            {
+              return 0;
+            }
+            entry = from.front();
+            from.pop_front();
+          }
+          entry.destroy( entry.p );
+        }
+        Lock lock( q );
+        return q.mainThread.size() + q.anyThread.size();
+      }
+
+      static std::size_t Pending()
+      {
+        auto& q = Instance();
+        Lock lock( q );
+        return q.mainThread.size() + q.anyThread.size();
+      }
+
+#if UPYWRAP_HAS_THREADS
+      //Destroy objects which may be destroyed on any thread as they come in, until stop is set.
+      static void DrainAnyThread( const bool& stop )
+      {
+        auto& q = Instance();
+        std::unique_lock< std::mutex > lock( q.mutex );
+        for( ; ; )
+        {
+          q.pushed.wait( lock, [&q, &stop] { return stop || !q.anyThread.empty(); } );
+          if( stop )
+          {
+            return;
+          }
+          const auto entry = q.anyThread.front();
+          q.anyThread.pop_front();
+          lock.unlock();
+          entry.destroy( entry.p );
+          lock.lock();
+        }
+      }
+
+      static void Stop( bool& stop )
+      {
+        auto& q = Instance();
+        {
+          std::lock_guard< std::mutex > lock( q.mutex );
+          stop = true;
+        }
+        q.pushed.notify_all();
+      }
+#endif
+
+    private:
+      struct Entry
+      {
+        void* p;
+        void( *destroy )( void* );
+      };
+
+      struct Queues
+      {
+        std::deque< Entry > mainThread;
+        std::deque< Entry > anyThread;
+#if UPYWRAP_HAS_THREADS
+        std::mutex mutex;
+        std::condition_variable pushed;
+#endif
+      };
+
+#if UPYWRAP_HAS_THREADS
+      struct Lock : std::lock_guard< std::mutex >
+      {
+        Lock( Queues& q ) :
+          std::lock_guard< std::mutex >( q.mutex )
+        {
+        }
+      };
+#else
+      struct Lock
+      {
+        Lock( Queues& )
+        {
+        }
+      };
+#endif
+
+      template< class T >
+      static void Delete( void* p )
+      {
+        delete static_cast< T* >( p );
+      }
+
+      //Never destroyed: finalisers might still run while statics get destructed.
+      static Queues& Instance()
+      {
+        static Queues* queues = new Queues();
+        return *queues;
+      }
+    };
+  }
+
+  //Destroy at most budget native objects queued because of DestructionMode, return the number still pending.
+  inline std::size_t DrainFinalizers( std::size_t budget = std::numeric_limits< std::size_t >::max() )
+  {
+    return detail::FinalizerQueue::Drain( budget );
+  }
+
+  //Number of native objects queued because of DestructionMode.
+  inline std::size_t PendingFinalizers()
+  {
+    return detail::FinalizerQueue::Pending();
+  }
+
+#if UPYWRAP_HAS_THREADS
+  //Background thread destroying objects with Destruction::DeferredAnyThread during its lifetime.
+  class FinalizerThread
+  {
+  public:
+    FinalizerThread() :
+      stop( false ),
+      thread( [this] { detail::FinalizerQueue::DrainAnyThread( stop ); } )
+    {
+    }
+
+    ~FinalizerThread()
+    {
+      detail::FinalizerQueue::Stop( stop );
+      thread.join();
+    }
+
+    FinalizerThread( const FinalizerThread& ) = delete;
+    FinalizerThread& operator = ( const FinalizerThread& ) = delete;
+
+  private:
+    bool stop;
+    std::thread thread;
+  };
+#endif
+}
+
+#endif //#ifndef MICROPYTHON_WRAP_DETAIL_FINALIZERQUEUE_H
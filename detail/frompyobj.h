@@ -1,15 +1,85 @@
 #ifndef MICROPYTHON_WRAP_DETAIL_FROMPYOBJ_H
 #define MICROPYTHON_WRAP_DETAIL_FROMPYOBJ_H
 
+#include "buffer.h"
+#include "iterable.h"
 #include "micropython.h"
 #include "topyobj.h"
 #include <functional>
+#if UPYWRAP_HAS_PMR
+#include <memory_resource>
+#endif
+#if UPYWRAP_HAS_CPP20
+#include <span>
+#endif
 
 namespace upywrap
 {
   template< class T >
   struct SelectFromPyObj;
 
+#if UPYWRAP_HAS_PMR
+  namespace detail
+  {
+    //Conversion for use with a memory resource: for the containers using it, i.e. those which
+    //have a static Convert( mp_obj_t, std::pmr::memory_resource* ), else just the normal conversion.
+    template< class Converter, class = void >
+    struct HasResourceConvert : std::false_type
+    {
+    };
+
+    template< class Converter >
+    struct HasResourceConvert< Converter, std::void_t< decltype( Converter::Convert( std::declval< mp_obj_t >(), std::declval< std::pmr::memory_resource* >() ) ) > > : std::true_type
+    {
+    };
+
+    template< class Converter >
+    auto ConvertWithResource( mp_obj_t arg, std::pmr::memory_resource* resource ) -> decltype( Converter::Convert( arg ) )
+    {
+      if constexpr( HasResourceConvert< Converter >::value )
+      {
+        return Converter::Convert( arg, resource );
+      }
+      else
+      {
+        (void) resource;
+        return Converter::Convert( arg );
+      }
+    }
+
+    template< class Alloc >
+    struct IsPolymorphicAllocator : std::false_type
+    {
+    };
+
+    template< class T >
+    struct IsPolymorphicAllocator< std::pmr::polymorphic_allocator< T > > : std::true_type
+    {
+    };
+
+    template< class T, class = void >
+    struct UsesPolymorphicAllocator : std::false_type
+    {
+    };
+
+    template< class T >
+    struct UsesPolymorphicAllocator< T, std::void_t< typename T::allocator_type > > :
+      IsPolymorphicAllocator< typename T::allocator_type >
+    {
+    };
+  }
+
+  inline bool HasPmr()
+  {
+    return true;
+  }
+#else
+  inline bool HasPmr()
+  {
+    return false;
+  }
+#endif
+
   //Test if the given type is a ClassWrapper< T >'s type
   template< class T >
   bool IsClassWrapperOfType( const mp_obj_type_t& type );
@@ -124,6 +194,24 @@ namespace upywrap
     }
   };
 
+  template<>
+  struct FromPyObj< std::int8_t > : std::true_type
+  {
+    static std::int8_t Convert( mp_obj_t arg )
+    {
+      return safe_integer_cast< std::int8_t >( FromPyObj< mp_int_t >::Convert( arg ) );
+    }
+  };
+
+  template<>
+  struct FromPyObj< std::uint8_t > : std::true_type
+  {
+    static std::uint8_t Convert( mp_obj_t arg )
+    {
+      return safe_integer_cast< std::uint8_t >( FromPyObj< mp_uint_t >::Convert( arg ) );
+    }
+  };
+
   template<>
   struct FromPyObj< std::int16_t > : std::true_type
   {
@@ -246,14 +334,32 @@ namespace upywrap
     }
   };
 
-  template<>
-  struct FromPyObj< std::string > : std::true_type
+  //Strings and containers work with any allocator: default-constructed for the plain conversion,
+  //and for std::pmr::polymorphic_allocator there's also a conversion using a given memory resource,
+  //which gets passed on to the items (see ConvertWithResource).
+  template< class Tr, class Alloc >
+  struct FromPyObj< std::basic_string< char, Tr, Alloc > > : std::true_type
   {
-    static std::string Convert( mp_obj_t arg )
+    typedef std::basic_string< char, Tr, Alloc > string_type;
+
+    static string_type Convert( mp_obj_t arg )
+    {
+      return Convert( arg, Alloc() );
+    }
+
+#if UPYWRAP_HAS_PMR
+    template< class A = Alloc, class = typename std::enable_if< detail::IsPolymorphicAllocator< A >::value >::type >
+    static string_type Convert( mp_obj_t arg, std::pmr::memory_resource* resource )
+    {
+      return Convert( arg, Alloc( resource ) );
+    }
+#endif
+
+    static string_type Convert( mp_obj_t arg, const Alloc& alloc )
     {
       size_t len;
       auto chars = mp_obj_str_get_data( arg, &len );
-      return std::string( chars, len );
+      return string_type( chars, len, alloc );
     }
   };
 
@@ -314,41 +420,442 @@ namespace upywrap
   }
   #endif
 
-  template< class T >
-  struct FromPyObj< std::vector< T > > : std::true_type
+  namespace detail
   {
-    typedef std::vector< T > vec_type;
+    //Fill a vector of arithmetic types from anything supporting the buffer protocol (bytes, bytearray, array, ...):
+    //a plain copy if the typecode matches, else the items are converted one by one.
+    //Returns false if arg has no (suitable) buffer.
+    template< class T, class Alloc >
+    typename std::enable_if< std::is_arithmetic< T >::value && !std::is_same< T, bool >::value, bool >::type
+      VectorFromBuffer( mp_obj_t arg, std::vector< T, Alloc >& ret )
+    {
+      mp_buffer_info_t bufinfo;
+      if( mp_obj_is_str( arg ) || !mp_get_buffer( arg, &bufinfo, MP_BUFFER_READ ) )
+      {
+        return false;
+      }
+      if( IsBufferTypeCodeOf< T >( bufinfo.typecode ) )
+      {
+        ret.resize( bufinfo.len / sizeof( T ) );
+        if( !ret.empty() )
+        {
+          std::memcpy( ret.data(), bufinfo.buf, ret.size() * sizeof( T ) );
+        }
+        return true;
+      }
+      const auto itemSize = mp_binary_get_size( '@', static_cast< char >( bufinfo.typecode ), nullptr );
+      const auto len = bufinfo.len / itemSize;
+      ret.resize( len );
+      for( size_t i = 0 ; i < len ; ++i )
+      {
+        ret[ i ] = SelectFromPyObj< T >::type::Convert( mp_binary_get_val_array( static_cast< char >( bufinfo.typecode ), bufinfo.buf, i ) );
+      }
+      return true;
+    }
 
-    static vec_type Convert( mp_obj_t arg )
+    template< class T, class Alloc >
+    typename std::enable_if< !std::is_arithmetic< T >::value || std::is_same< T, bool >::value, bool >::type
+      VectorFromBuffer( mp_obj_t, std::vector< T, Alloc >& )
+    {
+      return false;
+    }
+  }
+
+  namespace detail
+  {
+    //Bulk conversion of list/tuple items into a vector of integers for the common case where all items are small ints:
+    //one pass checking the tags and getting the value range, a single range check, then one pass converting.
+    //Returns false if any of the items is not a small int or out of range, in which case the regular
+    //per-item conversion should be used (which also raises the appropriate errors).
+    template< class T, class Alloc >
+    typename std::enable_if< std::is_integral< T >::value && !std::is_same< T, bool >::value, bool >::type
+      BulkFromItems( const mp_obj_t* items, size_t len, std::vector< T, Alloc >& ret )
+    {
+      if( !len )
+      {
+        return true;
+      }
+      bool allSmallInts = true;
+      mp_int_t minValue = MP_SMALL_INT_MAX;
+      mp_int_t maxValue = MP_SMALL_INT_MIN;
+      for( size_t i = 0 ; i < len ; ++i )
+      {
+        const auto value = MP_OBJ_SMALL_INT_VALUE( items[ i ] ); //garbage if not a small int but then it's not used
+        allSmallInts &= mp_obj_is_small_int( items[ i ] );
+        minValue = std::min( minValue, value );
+        maxValue = std::max( maxValue, value );
+      }
+      if( !allSmallInts )
+      {
+        return false;
+      }
+      const bool inRange = std::is_signed< T >::value ?
+        ( static_cast< std::intmax_t >( minValue ) >= static_cast< std::intmax_t >( std::numeric_limits< T >::min() ) &&
+          static_cast< std::intmax_t >( maxValue ) <= static_cast< std::intmax_t >( std::numeric_limits< T >::max() ) ) :
+        ( minValue >= 0 && static_cast< std::uintmax_t >( maxValue ) <= static_cast< std::uintmax_t >( std::numeric_limits< T >::max() ) );
+      if( !inRange )
+      {
+        return false;
+      }
+      for( size_t i = 0 ; i < len ; ++i )
+      {
+        ret[ i ] = static_cast< T >( MP_OBJ_SMALL_INT_VALUE( items[ i ] ) );
+      }
+      return true;
+    }
+
+    //Same for floating point: items can be floats or small ints, and for float the range is checked once.
+    template< class T, class Alloc >
+    typename std::enable_if< std::is_floating_point< T >::value, bool >::type
+      BulkFromItems( const mp_obj_t* items, size_t len, std::vector< T, Alloc >& ret )
+    {
+      double maxAbsValue = 0.0;
+      for( size_t i = 0 ; i < len ; ++i )
+      {
+        double value;
+        if( mp_obj_is_small_int( items[ i ] ) )
+        {
+          value = static_cast< double >( MP_OBJ_SMALL_INT_VALUE( items[ i ] ) );
+        }
+        else if( mp_obj_is_float( items[ i ] ) )
+        {
+          value = static_cast< double >( mp_obj_float_get( items[ i ] ) );
+        }
+        else
+        {
+          return false;
+        }
+        maxAbsValue = std::max( maxAbsValue, std::abs( value ) );
+        ret[ i ] = static_cast< T >( value );
+      }
+      if( sizeof( T ) < sizeof( double ) && maxAbsValue > static_cast< double >( std::numeric_limits< T >::max() ) )
+      {
+        RaiseOverflowException( "Integer overflow" );
+      }
+      return true;
+    }
+
+    template< class T, class Alloc >
+    typename std::enable_if< !std::is_arithmetic< T >::value || std::is_same< T, bool >::value, bool >::type
+      BulkFromItems( const mp_obj_t*, size_t, std::vector< T, Alloc >& )
     {
+      return false;
+    }
+
+    //Fill vector from list, tuple or buffer, converting items with convertItem if needed.
+    template< class T, class Alloc, class ConvertItem >
+    void FillVector( mp_obj_t arg, std::vector< T, Alloc >& ret, ConvertItem convertItem )
+    {
+      if( VectorFromBuffer( arg, ret ) )
+      {
+        return;
+      }
       size_t len;
       mp_obj_t* items;
       mp_obj_get_array( arg, &len, &items ); //works for list and tuple
-      vec_type ret( len );
-      std::transform( items, items + len, ret.begin(), SelectFromPyObj< T >::type::Convert );
+      ret.resize( len );
+      if( !BulkFromItems( items, len, ret ) )
+      {
+        std::transform( items, items + len, ret.begin(), convertItem );
+      }
+    }
+  }
+
+  template< class T, class Alloc >
+  struct FromPyObj< std::vector< T, Alloc > > : std::true_type
+  {
+    typedef std::vector< T, Alloc > vec_type;
+
+    static vec_type Convert( mp_obj_t arg )
+    {
+      vec_type ret;
+      detail::FillVector( arg, ret, [] ( mp_obj_t item )
+      {
+        return SelectFromPyObj< T >::type::Convert( item );
+      } );
       return ret;
     }
+
+#if UPYWRAP_HAS_PMR
+    template< class A = Alloc, class = typename std::enable_if< detail::IsPolymorphicAllocator< A >::value >::type >
+    static vec_type Convert( mp_obj_t arg, std::pmr::memory_resource* resource )
+    {
+      vec_type ret( resource );
+      detail::FillVector( arg, ret, [resource] ( mp_obj_t item )
+      {
+        return detail::ConvertWithResource< typename SelectFromPyObj< T >::type >( item, resource );
+      } );
+      return ret;
+    }
+#endif
   };
 
-  template< class K, class V >
-  struct FromPyObj< std::map< K, V > > : std::true_type
+  namespace detail
   {
-    typedef std::map< K, V > map_type;
+    //Get the buffer of arg for direct use as T, so the typecode must match exactly.
+    template< class T >
+    mp_buffer_info_t GetBufferOf( mp_obj_t arg )
+    {
+      mp_buffer_info_t bufinfo;
+      mp_get_buffer_raise( arg, &bufinfo, std::is_const< T >::value ? MP_BUFFER_READ : MP_BUFFER_WRITE );
+      if( !IsBufferTypeCodeOf< typename std::remove_const< T >::type >( bufinfo.typecode ) )
+      {
+        RaiseTypeException( "Buffer typecode does not match native type" );
+      }
+      return bufinfo;
+    }
+  }
 
-    static map_type Convert( mp_obj_t arg )
+  template< class T >
+  struct FromPyObj< BufferView< T > > : std::true_type
+  {
+    static BufferView< T > Convert( mp_obj_t arg )
     {
-      map_type ret;
-      const auto dict = static_cast< mp_obj_dict_t* >( MP_OBJ_TO_PTR( arg ) );
-      const auto map = &dict->map;
+      const auto bufinfo = detail::GetBufferOf< T >( arg );
+      return BufferView< T >( static_cast< T* >( bufinfo.buf ), bufinfo.len / sizeof( T ) );
+    }
+  };
+
+  template< class T >
+  struct FromPyObj< Iterable< T > > : std::true_type
+  {
+    static Iterable< T > Convert( mp_obj_t arg )
+    {
+      //Get the iterator right away so non-iterables raise TypeError before the native call.
+      return Iterable< T >( mp_getiter( arg, nullptr ) );
+    }
+  };
+
+#if UPYWRAP_HAS_CPP20
+  template< class T >
+  struct FromPyObj< std::span< T > > : std::true_type
+  {
+    static std::span< T > Convert( mp_obj_t arg )
+    {
+      const auto bufinfo = detail::GetBufferOf< T >( arg );
+      return std::span< T >( static_cast< T* >( bufinfo.buf ), bufinfo.len / sizeof( T ) );
+    }
+  };
+
+  inline bool HasSpan()
+  {
+    return true;
+  }
+#else
+  inline bool HasSpan()
+  {
+    return false;
+  }
+#endif
+
+  namespace detail
+  {
+    inline const mp_map_t* DictMap( mp_obj_t arg )
+    {
+      if( !mp_obj_is_dict_or_ordereddict( arg ) )
+      {
+        RaiseTypeException( arg, "dict" );
+      }
+      return &static_cast< mp_obj_dict_t* >( MP_OBJ_TO_PTR( arg ) )->map;
+    }
+
+    //Fill map-like container from dict, converting keys and values with the given functions.
+    template< class Map, class ConvertKey, class ConvertValue >
+    void FillMap( mp_obj_t arg, Map& ret, ConvertKey convertKey, ConvertValue convertValue )
+    {
+      const auto map = DictMap( arg );
       //this is basically dict_iter_next but that isn't exposed as an API method
       for( size_t i = 0 ; i < map->alloc ; ++i )
       {
         if( mp_map_slot_is_filled( map, i ) )
         {
-          ret.emplace( SelectFromPyObj< K >::type::Convert( map->table[ i ].key ),
-                       SelectFromPyObj< V >::type::Convert( map->table[ i ].value ) );
+          ret.emplace( convertKey( map->table[ i ].key ), convertValue( map->table[ i ].value ) );
         }
       }
+    }
+
+    //Dict items come in hash order so inserting them into a tree one by one means a full
+    //search for each of them. For larger dicts it's cheaper to convert the items into a vector,
+    //sort that and then insert everything at the end of the tree (constant time using a hint).
+    const size_t sortedMapInsertThreshold = 16;
+
+    template< class K, class V, class Cmp, class Alloc, class ConvertKey, class ConvertValue >
+    void FillSortedMap( mp_obj_t arg, std::map< K, V, Cmp, Alloc >& ret, ConvertKey convertKey, ConvertValue convertValue )
+    {
+      const auto map = DictMap( arg );
+      if( map->used < sortedMapInsertThreshold )
+      {
+        FillMap( arg, ret, convertKey, convertValue );
+        return;
+      }
+      //Scratch space comes from the same place as the map's nodes, e.g. the scratch arena for std::pmr::map.
+      typedef typename std::allocator_traits< Alloc >::template rebind_alloc< std::pair< K, V > > item_alloc;
+      std::vector< std::pair< K, V >, item_alloc > items( item_alloc( ret.get_allocator() ) );
+      items.reserve( map->used );
+      for( size_t i = 0 ; i < map->alloc ; ++i )
+      {
+        if( mp_map_slot_is_filled( map, i ) )
+        {
+          items.emplace_back( convertKey( map->table[ i ].key ), convertValue( map->table[ i ].value ) );
+        }
+      }
+      const auto keyComp = ret.key_comp();
+      std::sort( items.begin(), items.end(), [&keyComp] ( const std::pair< K, V >& a, const std::pair< K, V >& b )
+      {
+        return keyComp( a.first, b.first );
+      } );
+      for( auto& item : items )
+      {
+        ret.emplace_hint( ret.cend(), std::move( item.first ), std::move( item.second ) );
+      }
+    }
+
+    //Call fun for each item of a list or tuple, or else of any other iterable.
+    template< class Fun >
+    void ForEachItem( mp_obj_t arg, Fun fun )
+    {
+      if( mp_obj_is_type( arg, &mp_type_list ) || mp_obj_is_type( arg, &mp_type_tuple ) )
+      {
+        size_t len;
+        mp_obj_t* items;
+        mp_obj_get_array( arg, &len, &items );
+        std::for_each( items, items + len, fun );
+        return;
+      }
+      mp_obj_iter_buf_t iterBuf;
+      const auto iter = mp_getiter( arg, &iterBuf );
+      for( auto item = mp_iternext( iter ) ; item != MP_OBJ_STOP_ITERATION ; item = mp_iternext( iter ) )
+      {
+        fun( item );
+      }
+    }
+
+    //Number of items for objects which have a length, else 0.
+    inline size_t LengthHint( mp_obj_t arg )
+    {
+      const auto len = mp_obj_len_maybe( arg );
+      return len == MP_OBJ_NULL ? 0 : static_cast< size_t >( MP_OBJ_SMALL_INT_VALUE( len ) );
+    }
+  }
+
+  template< class K, class V, class Cmp, class Alloc >
+  struct FromPyObj< std::map< K, V, Cmp, Alloc > > : std::true_type
+  {
+    typedef std::map< K, V, Cmp, Alloc > map_type;
+
+    static map_type Convert( mp_obj_t arg )
+    {
+      map_type ret;
+      detail::FillSortedMap( arg, ret,
+                             [] ( mp_obj_t key ) { return SelectFromPyObj< K >::type::Convert( key ); },
+                             [] ( mp_obj_t value ) { return SelectFromPyObj< V >::type::Convert( value ); } );
+      return ret;
+    }
+
+#if UPYWRAP_HAS_PMR
+    template< class A = Alloc, class = typename std::enable_if< detail::IsPolymorphicAllocator< A >::value >::type >
+    static map_type Convert( mp_obj_t arg, std::pmr::memory_resource* resource )
+    {
+      map_type ret( resource );
+      detail::FillSortedMap( arg, ret,
+                             [resource] ( mp_obj_t key ) { return detail::ConvertWithResource< typename SelectFromPyObj< K >::type >( key, resource ); },
+                             [resource] ( mp_obj_t value ) { return detail::ConvertWithResource< typename SelectFromPyObj< V >::type >( value, resource ); } );
+      return ret;
+    }
+#endif
+  };
+
+  template< class K, class V, class Hash, class Eq, class Alloc >
+  struct FromPyObj< std::unordered_map< K, V, Hash, Eq, Alloc > > : std::true_type
+  {
+    typedef std::unordered_map< K, V, Hash, Eq, Alloc > map_type;
+
+    static map_type Convert( mp_obj_t arg )
+    {
+      map_type ret;
+      ret.reserve( detail::DictMap( arg )->used );
+      detail::FillMap( arg, ret,
+                       [] ( mp_obj_t key ) { return SelectFromPyObj< K >::type::Convert( key ); },
+                       [] ( mp_obj_t value ) { return SelectFromPyObj< V >::type::Convert( value ); } );
+      return ret;
+    }
+  };
+
+  //Sets, deques and lists can be created from any iterable, not just lists and tuples.
+  template< class T, class Cmp, class Alloc >
+  struct FromPyObj< std::set< T, Cmp, Alloc > > : std::true_type
+  {
+    static std::set< T, Cmp, Alloc > Convert( mp_obj_t arg )
+    {
+      std::set< T, Cmp, Alloc > ret;
+      detail::ForEachItem( arg, [&ret] ( mp_obj_t item )
+      {
+        ret.emplace_hint( ret.cend(), SelectFromPyObj< T >::type::Convert( item ) );
+      } );
+      return ret;
+    }
+  };
+
+  template< class T, class Hash, class Eq, class Alloc >
+  struct FromPyObj< std::unordered_set< T, Hash, Eq, Alloc > > : std::true_type
+  {
+    static std::unordered_set< T, Hash, Eq, Alloc > Convert( mp_obj_t arg )
+    {
+      std::unordered_set< T, Hash, Eq, Alloc > ret;
+      ret.reserve( detail::LengthHint( arg ) );
+      detail::ForEachItem( arg, [&ret] ( mp_obj_t item )
+      {
+        ret.emplace( SelectFromPyObj< T >::type::Convert( item ) );
+      } );
+      return ret;
+    }
+  };
+
+  template< class T, class Alloc >
+  struct FromPyObj< std::deque< T, Alloc > > : std::true_type
+  {
+    static std::deque< T, Alloc > Convert( mp_obj_t arg )
+    {
+      std::deque< T, Alloc > ret;
+      detail::ForEachItem( arg, [&ret] ( mp_obj_t item )
+      {
+        ret.emplace_back( SelectFromPyObj< T >::type::Convert( item ) );
+      } );
+      return ret;
+    }
+  };
+
+  template< class T, class Alloc >
+  struct FromPyObj< std::list< T, Alloc > > : std::true_type
+  {
+    static std::list< T, Alloc > Convert( mp_obj_t arg )
+    {
+      std::list< T, Alloc > ret;
+      detail::ForEachItem( arg, [&ret] ( mp_obj_t item )
+      {
+        ret.emplace_back( SelectFromPyObj< T >::type::Convert( item ) );
+      } );
+      return ret;
+    }
+  };
+
+  template< class T, std::size_t N >
+  struct FromPyObj< std::array< T, N > > : std::true_type
+  {
+    static std::array< T, N > Convert( mp_obj_t arg )
+    {
+      size_t len;
+      mp_obj_t* items;
+      mp_obj_get_array( arg, &len, &items );
+      if( len != N )
+      {
+        RaiseValueException( "Wrong number of array elements" );
+      }
+      std::array< T, N > ret;
+      std::transform( items, items + N, ret.begin(), [] ( mp_obj_t item )
+      {
+        return SelectFromPyObj< T >::type::Convert( item );
+      } );
       return ret;
     }
   };
@@ -556,6 +1063,55 @@ namespace upywrap
     return SelectFromPyObj< T >::type::Convert( arg );
   }
 
+  //Arena used when converting arguments for a native call, see UPYWRAP_SCRATCHARENA.
+  //The default does nothing special.
+  struct NoScratchArena
+  {
+  };
+
+  template< class T >
+  auto FromPy( const mp_obj_t arg, NoScratchArena& ) -> decltype( SelectFromPyObj< T >::type::Convert( arg ) )
+  {
+    return SelectFromPyObj< T >::type::Convert( arg );
+  }
+
+#if UPYWRAP_SCRATCHARENA
+  class ScratchArena
+  {
+  public:
+    ScratchArena() :
+      resource( buffer, sizeof( buffer ) )
+    {
+    }
+
+    ScratchArena( const ScratchArena& ) = delete;
+    ScratchArena& operator = ( const ScratchArena& ) = delete;
+
+    std::pmr::memory_resource* Resource()
+    {
+      return &resource;
+    }
+
+  private:
+    alignas( std::max_align_t ) unsigned char buffer[ UPYWRAP_SCRATCHARENASIZE ];
+    std::pmr::monotonic_buffer_resource resource;
+  };
+
+  template< class T >
+  auto FromPy( const mp_obj_t arg, ScratchArena& arena ) -> decltype( SelectFromPyObj< T >::type::Convert( arg ) )
+  {
+    return detail::ConvertWithResource< typename SelectFromPyObj< T >::type >( arg, arena.Resource() );
+  }
+
+  //Only functions which have arguments using polymorphic_allocator need an actual arena.
+  template< class... A >
+  using SelectScratchArena = typename std::conditional< std::disjunction< detail::UsesPolymorphicAllocator< typename remove_all< A >::type >... >::value,
+                                                        ScratchArena, NoScratchArena >::type;
+#else
+  template< class... A >
+  using SelectScratchArena = NoScratchArena;
+#endif
+
   //Helper for getting an argument in a function with variable number of arguments.
   template< class T >
   T FromPy( mp_uint_t numArgs, const mp_obj_t* args, mp_uint_t argIndex, const T& def )
@@ -265,6 +265,50 @@ namespace upywrap
     //Optional/keyword arguments.
     Arguments arguments;
   };
+
+#if UPYWRAP_HAS_CPP17
+  //Function objects for functions registered as Def< name, &Function >(): the function is a template
+  //argument so there's nothing to store, there's no virtual call and the call can be inlined.
+  //There's also no return value converter, see BoundCallReturn.
+
+  //Member function call (const or not), also for members of base classes of T
+  template< auto f, class T, class Ret, class... A >
+  struct BoundMemberFunctionCall
+  {
+    static Ret Call( T* p, A&&... a ) { return ( p->*f )( std::forward< A >( a )... ); }
+  };
+
+  //Non-member function taking T* as first argument
+  template< auto f, class T, class Ret, class... A >
+  struct BoundNonMemberFunctionCall
+  {
+    static Ret Call( T* p, A&&... a ) { return f( p, std::forward< A >( a )... ); }
+  };
+
+  //Non-member function taking T& or const T& as first argument
+  template< auto f, class T, class Ret, class... A >
+  struct BoundNonMemberByRefFunctionCall
+  {
+    static Ret Call( T* p, A&&... a ) { assert( p ); return f( *p, std::forward< A >( a )... ); }
+  };
+
+  //Standard function call
+  template< auto f, class Ret, class... A >
+  struct BoundFunctionCall
+  {
+    static Ret Call( A&&... a ) { return f( std::forward< A >( a )... ); }
+  };
+
+  inline bool HasBoundDef()
+  {
+    return true;
+  }
+#else
+  inline bool HasBoundDef()
+  {
+    return false;
+  }
+#endif
 }
 
 #endif //#ifndef MICROPYTHON_WRAP_DETAIL_FUNCTIONCALL_H
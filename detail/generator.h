@@ -0,0 +1,142 @@
+#ifndef MICROPYTHON_WRAP_DETAIL_GENERATOR_H
+#define MICROPYTHON_WRAP_DETAIL_GENERATOR_H
+
+#include "configuration.h"
+#if UPYWRAP_HAS_COROUTINES
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <utility>
+#endif
+
+namespace upywrap
+{
+#if UPYWRAP_HAS_COROUTINES
+  //Coroutine return type for producing items lazily: returned to uPy this becomes an iterator
+  //which resumes the coroutine each time the next item is requested and only then converts it,
+  //so items get streamed to scripts one by one instead of being collected in a container first:
+  //
+  //Generator< int > Range( int n )
+  //{
+  //  for( int i = 0 ; i < n ; ++i )
+  //  {
+  //    co_yield i;
+  //  }
+  //}
+  //
+  //Since the coroutine's state lives on the native heap it should not hold on to uPy objects,
+  //which the GC cannot see there, and it should not call uPy functions which might raise.
+  template< class T >
+  class Generator
+  {
+  public:
+    struct promise_type
+    {
+      Generator get_return_object()
+      {
+        return Generator( handle_type::from_promise( *this ) );
+      }
+
+      std::suspend_always initial_suspend() noexcept
+      {
+        return {};
+      }
+
+      std::suspend_always final_suspend() noexcept
+      {
+        return {};
+      }
+
+      //The yielded value stays alive until the coroutine is resumed, so no need to copy it.
+      std::suspend_always yield_value( const T& yielded ) noexcept
+      {
+        value = std::addressof( yielded );
+        return {};
+      }
+
+      void return_void() noexcept
+      {
+      }
+
+      void unhandled_exception()
+      {
+        exception = std::current_exception();
+      }
+
+      const T* value = nullptr;
+      std::exception_ptr exception;
+    };
+
+    using handle_type = std::coroutine_handle< promise_type >;
+
+    explicit Generator( handle_type coro ) :
+      coro( coro )
+    {
+    }
+
+    Generator( Generator&& rhs ) noexcept :
+      coro( std::move( rhs ).Release() )
+    {
+    }
+
+    Generator& operator = ( Generator&& rhs ) noexcept
+    {
+      if( this != &rhs )
+      {
+        Destroy();
+        coro = std::move( rhs ).Release();
+      }
+      return *this;
+    }
+
+    ~Generator()
+    {
+      Destroy();
+    }
+
+    //Run until the next item, returns nullptr when done. Exceptions thrown by the coroutine are rethrown.
+    const T* Next()
+    {
+      if( !coro || coro.done() )
+      {
+        return nullptr;
+      }
+      coro.resume();
+      if( coro.promise().exception )
+      {
+        std::rethrow_exception( std::exchange( coro.promise().exception, nullptr ) );
+      }
+      return coro.done() ? nullptr : coro.promise().value;
+    }
+
+    //Take over the coroutine, leaving this empty.
+    handle_type Release() &&
+    {
+      return std::exchange( coro, nullptr );
+    }
+
+  private:
+    void Destroy()
+    {
+      if( coro )
+      {
+        coro.destroy();
+      }
+    }
+
+    handle_type coro;
+  };
+
+  inline bool HasCoroutines()
+  {
+    return true;
+  }
+#else
+  inline bool HasCoroutines()
+  {
+    return false;
+  }
+#endif
+}
+
+#endif //#ifndef MICROPYTHON_WRAP_DETAIL_GENERATOR_H
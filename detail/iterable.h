@@ -0,0 +1,130 @@
+#ifndef MICROPYTHON_WRAP_DETAIL_ITERABLE_H
+#define MICROPYTHON_WRAP_DETAIL_ITERABLE_H
+
+#include "micropython.h"
+#include <cstddef>
+#include <iterator>
+
+namespace upywrap
+{
+  template< class T >
+  struct SelectFromPyObj;
+
+  //Any uPy iterable (list, generator, range, ...) used as function argument, for consuming the items
+  //one at a time as T, in a range-based for loop or with standard algorithms taking input iterators.
+  //Unlike conversion to std::vector this doesn't require a list or tuple and doesn't store all items,
+  //so arbitrarily long streams can be passed with constant memory. Items are converted when dereferencing
+  //the iterator so conversion errors are raised at that point. Like in Python iteration is single-pass:
+  //begin() continues where previous iteration stopped. Since the uPy iterator is only reachable by the GC
+  //through the stack, this is only valid during the native call.
+  template< class T >
+  class Iterable
+  {
+  public:
+    class iterator
+    {
+    public:
+      //What it++ returns: the iterator can't go back so this holds on to the item it pointed to, for *it++.
+      class proxy
+      {
+      public:
+        T operator * () const
+        {
+          return SelectFromPyObj< T >::type::Convert( item );
+        }
+
+      private:
+        friend class iterator;
+
+        explicit proxy( mp_obj_t item ) :
+          item( item )
+        {
+        }
+
+        mp_obj_t item;
+      };
+
+      typedef std::input_iterator_tag iterator_category;
+      typedef T value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef void pointer;
+      typedef T reference;
+
+      iterator() :
+        iter( MP_OBJ_NULL ),
+        item( MP_OBJ_STOP_ITERATION )
+      {
+      }
+
+      //The next item is only fetched when it is needed (MP_OBJ_SENTINEL means not fetched yet), so breaking
+      //out of a loop right after incrementing doesn't consume an item which then never gets used.
+      explicit iterator( mp_obj_t iter ) :
+        iter( iter ),
+        item( MP_OBJ_SENTINEL )
+      {
+      }
+
+      T operator * () const
+      {
+        return SelectFromPyObj< T >::type::Convert( Fetch() );
+      }
+
+      iterator& operator ++ ()
+      {
+        Fetch();
+        item = MP_OBJ_SENTINEL;
+        return *this;
+      }
+
+      proxy operator ++ ( int )
+      {
+        const proxy current( Fetch() );
+        ++*this;
+        return current;
+      }
+
+      bool operator == ( const iterator& rhs ) const
+      {
+        return ( Fetch() == MP_OBJ_STOP_ITERATION ) == ( rhs.Fetch() == MP_OBJ_STOP_ITERATION );
+      }
+
+      bool operator != ( const iterator& rhs ) const
+      {
+        return !( *this == rhs );
+      }
+
+    private:
+      mp_obj_t Fetch() const
+      {
+        if( item == MP_OBJ_SENTINEL )
+        {
+          item = mp_iternext( iter );
+        }
+        return item;
+      }
+
+      mp_obj_t iter;
+      mutable mp_obj_t item;
+    };
+
+    explicit Iterable( mp_obj_t iter ) :
+      iter( iter )
+    {
+    }
+
+    iterator begin() const
+    {
+      return iterator( iter );
+    }
+
+    iterator end() const
+    {
+      return iterator();
+    }
+
+  private:
+    mp_obj_t iter;
+  };
+}
+
+#endif //#ifndef MICROPYTHON_WRAP_DETAIL_ITERABLE_H
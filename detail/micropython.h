@@ -134,6 +134,11 @@ namespace upywrap
     mp_raise_msg_varg( &mp_type_AttributeError, MP_ERROR_TEXT( "'%s' object has no attribute '%s'" ), qstr_str( name ), qstr_str( attr ) );
   }
 
+  inline mp_obj_t RaiseValueException( const char* msg )
+  {
+    return RaiseException( &mp_type_ValueError, msg );
+  }
+
   inline mp_obj_t RaiseOverflowException( const char* msg )
   {
     return RaiseException( &mp_type_OverflowError, msg );
@@ -222,6 +227,26 @@ namespace upywrap
     }
   }
 
+  template<>
+  struct safe_integer_caster< mp_int_t, std::int8_t >
+  {
+    static std::int8_t Convert( mp_int_t src )
+    {
+      IntegerBoundCheck< std::int8_t >( src );
+      return static_cast< std::int8_t >( src );
+    }
+  };
+
+  template<>
+  struct safe_integer_caster< mp_uint_t, std::uint8_t >
+  {
+    static std::uint8_t Convert( mp_uint_t src )
+    {
+      IntegerBoundCheck< std::uint8_t >( src );
+      return static_cast< std::uint8_t >( src );
+    }
+  };
+
   template<>
   struct safe_integer_caster< mp_int_t, std::int16_t >
   {
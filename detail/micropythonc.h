@@ -10,6 +10,8 @@
 extern "C"
 {
 #endif
+#include <py/binary.h>
+#include <py/objarray.h>
 #include <py/objfun.h>
 #include <py/objint.h>
 #include <py/objmodule.h>
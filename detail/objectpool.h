@@ -0,0 +1,148 @@
+#ifndef MICROPYTHON_WRAP_DETAIL_OBJECTPOOL_H
+#define MICROPYTHON_WRAP_DETAIL_OBJECTPOOL_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+namespace upywrap
+{
+  //Specialize this for T to have ClassWrapper< T > recycle the memory of native objects it creates (with DefInit,
+  //or when converting a T returned by value, using UPYWRAP_SHAREDPTROBJ) instead of going back to the heap every time:
+  //
+  //template<>
+  //struct PoolSize< Vec3 > : std::integral_constant< std::size_t, 64 >
+  //{
+  //};
+  //
+  //When an instance gets garbage collected the memory of its native object (which includes the
+  //shared_ptr control block) is kept in a free list, up to the given number of blocks, and handed out
+  //again for the next instance. The pool is not thread-safe: don't use it for types of which the
+  //shared_ptr might get released on another thread. Also see ClassWrapper::PoolStatistics.
+  template< class T >
+  struct PoolSize : std::integral_constant< std::size_t, 0 >
+  {
+  };
+
+  //Counters of the pool for a type.
+  struct PoolStats
+  {
+    std::size_t hits; //allocations served from the pool
+    std::size_t misses; //allocations which had to go to the heap
+    std::size_t size; //number of blocks currently in the pool
+  };
+
+  namespace detail
+  {
+    //Free list of equally sized memory blocks, one per T. The block size is that of the first allocation:
+    //allocate_shared only ever asks for its control block with T in it so other sizes just bypass the pool.
+    //Only has static members without destructor so it stays usable while statics get destructed.
+    template< class T >
+    class ObjectPool
+    {
+    public:
+      static void* Allocate( std::size_t n )
+      {
+        if( n == blockSize && head )
+        {
+          auto node = head;
+          head = node->next;
+          --stats.size;
+          ++stats.hits;
+          return node;
+        }
+        if( !blockSize && n >= sizeof( Node ) )
+        {
+          blockSize = n;
+        }
+        ++stats.misses;
+        return ::operator new( n );
+      }
+
+      static void Deallocate( void* p, std::size_t n )
+      {
+        if( n == blockSize && stats.size < PoolSize< T >::value )
+        {
+          head = new( p ) Node{ head };
+          ++stats.size;
+          return;
+        }
+        ::operator delete( p );
+      }
+
+      static const PoolStats& Stats()
+      {
+        return stats;
+      }
+
+    private:
+      struct Node
+      {
+        Node* next;
+      };
+
+      static std::size_t blockSize;
+      static Node* head;
+      static PoolStats stats;
+    };
+
+    template< class T >
+    std::size_t ObjectPool< T >::blockSize = 0;
+
+    template< class T >
+    typename ObjectPool< T >::Node* ObjectPool< T >::head = nullptr;
+
+    template< class T >
+    PoolStats ObjectPool< T >::stats = {};
+  }
+
+  //Allocator getting memory from the pool of T, whatever it gets rebound to. Instances created by ClassWrapper< T >
+  //already use it, for native functions returning shared_ptr< T > use std::allocate_shared with it as well:
+  //
+  //return std::allocate_shared< Vec3 >( upywrap::PoolAllocator< Vec3 >(), x, y, z );
+  template< class U, class T = U >
+  struct PoolAllocator
+  {
+    using value_type = U;
+
+    template< class V >
+    struct rebind
+    {
+      using other = PoolAllocator< V, T >;
+    };
+
+    PoolAllocator()
+    {
+    }
+
+    template< class V >
+    PoolAllocator( const PoolAllocator< V, T >& )
+    {
+    }
+
+    U* allocate( std::size_t n )
+    {
+      static_assert( alignof( U ) <= alignof( std::max_align_t ), "Over-aligned types cannot be pooled" );
+      return static_cast< U* >( detail::ObjectPool< T >::Allocate( n * sizeof( U ) ) );
+    }
+
+    void deallocate( U* p, std::size_t n )
+    {
+      detail::ObjectPool< T >::Deallocate( p, n * sizeof( U ) );
+    }
+
+    template< class V >
+    bool operator == ( const PoolAllocator< V, T >& ) const
+    {
+      return true;
+    }
+
+    template< class V >
+    bool operator != ( const PoolAllocator< V, T >& ) const
+    {
+      return false;
+    }
+  };
+}
+
+#endif //#ifndef MICROPYTHON_WRAP_DETAIL_OBJECTPOOL_H
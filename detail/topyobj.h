@@ -1,14 +1,22 @@
 #ifndef MICROPYTHON_WRAP_DETAIL_TOPYOBJ_H
 #define MICROPYTHON_WRAP_DETAIL_TOPYOBJ_H
 
+#include "buffer.h"
 #include "micropython.h"
 #include "util.h"
 #include <algorithm>
+#include <array>
 #include <cstring>
+#include <deque>
+#include <iterator>
+#include <list>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <tuple>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #if UPYWRAP_HAS_CPP17
 #include <optional>
@@ -73,6 +81,24 @@ namespace upywrap
     }
   };
 
+  template<>
+  struct ToPyObj< std::int8_t > : std::true_type
+  {
+    static mp_obj_t Convert( std::int8_t arg )
+    {
+      return ToPyObj< mp_int_t >::Convert( static_cast< std::int8_t >( arg ) );
+    }
+  };
+
+  template<>
+  struct ToPyObj< std::uint8_t > : std::true_type
+  {
+    static mp_obj_t Convert( std::uint8_t arg )
+    {
+      return ToPyObj< mp_uint_t >::Convert( static_cast< std::uint8_t >( arg ) );
+    }
+  };
+
   template<>
   struct ToPyObj< std::int16_t > : std::true_type
   {
@@ -157,10 +183,10 @@ namespace upywrap
     }
   };
 
-  template<>
-  struct ToPyObj< std::string > : std::true_type
+  template< class Tr, class Alloc >
+  struct ToPyObj< std::basic_string< char, Tr, Alloc > > : std::true_type
   {
-    static mp_obj_t Convert( const std::string& a )
+    static mp_obj_t Convert( const std::basic_string< char, Tr, Alloc >& a )
     {
       return mp_obj_new_str( reinterpret_cast< const char* >( a.data() ), a.length() );
     }
@@ -232,34 +258,249 @@ namespace upywrap
   static mp_obj_t ConvertToList( It begin, size_t numItems, Transform transform )
   {
     auto list = reinterpret_cast< mp_obj_list_t* >( MP_OBJ_TO_PTR( mp_obj_new_list( numItems, nullptr ) ) );
-    std::transform( begin, begin + numItems, list->items, transform );
+    std::transform( begin, std::next( begin, numItems ), list->items, transform );
     return list;
   }
 
+  namespace detail
+  {
+    template< class T >
+    bool SmallIntFits( T value, typename std::enable_if< std::is_signed< T >::value >::type* = nullptr )
+    {
+      return static_cast< std::intmax_t >( value ) >= static_cast< std::intmax_t >( MP_SMALL_INT_MIN ) &&
+             static_cast< std::intmax_t >( value ) <= static_cast< std::intmax_t >( MP_SMALL_INT_MAX );
+    }
+
+    template< class T >
+    bool SmallIntFits( T value, typename std::enable_if< std::is_unsigned< T >::value >::type* = nullptr )
+    {
+      return static_cast< std::uintmax_t >( value ) <= static_cast< std::uintmax_t >( MP_SMALL_INT_MAX );
+    }
+
+    template< class T >
+    mp_obj_t NewSmallInt( T value )
+    {
+      return MP_OBJ_NEW_SMALL_INT( static_cast< mp_int_t >( value ) );
+    }
+
+    //For integers check once if the whole range fits in small ints, if so that skips the
+    //per-item range check and possible allocation done by mp_obj_new_int.
+    template< class T, class Alloc >
+    typename std::enable_if< std::is_integral< T >::value && !std::is_same< T, bool >::value, mp_obj_t >::type
+      VectorToList( const std::vector< T, Alloc >& a )
+    {
+      const auto minMax = std::minmax_element( a.cbegin(), a.cend() );
+      if( a.empty() || ( SmallIntFits( *minMax.first ) && SmallIntFits( *minMax.second ) ) )
+      {
+        return ConvertToList( a.cbegin(), a.size(), NewSmallInt< T > );
+      }
+      return ConvertToList( a.cbegin(), a.size(), SelectToPyObj< T >::type::Convert );
+    }
+
+    template< class T, class Alloc >
+    typename std::enable_if< !std::is_integral< T >::value || std::is_same< T, bool >::value, mp_obj_t >::type
+      VectorToList( const std::vector< T, Alloc >& a )
+    {
+      return ConvertToList( a.cbegin(), a.size(), SelectToPyObj< T >::type::Convert );
+    }
+  }
+
+  template< class T, class Alloc >
+  struct ToPyObj< std::vector< T, Alloc > > : std::true_type
+  {
+    static mp_obj_t Convert( const std::vector< T, Alloc >& a )
+    {
+      return detail::VectorToList( a );
+    }
+  };
+
+  //Return type wrappers for returning a std::vector of integer or floating point values as array.array
+  //respectively a std::vector of bytes as bytearray instead of as a list: this takes a single allocation
+  //and copy for all items instead of creating an object for each of them.
+  template< class Vec >
+  struct AsArray
+  {
+    AsArray( Vec value ) :
+      value( std::move( value ) )
+    {
+    }
+
+    Vec value;
+  };
+
+  template< class Vec >
+  struct AsByteArray
+  {
+    AsByteArray( Vec value ) :
+      value( std::move( value ) )
+    {
+    }
+
+    Vec value;
+  };
+
+#if MICROPY_PY_ARRAY
+  //Create array.array with a copy of the given items.
   template< class T >
-  struct ToPyObj< std::vector< T > > : std::true_type
+  mp_obj_t NewArray( const T* items, size_t numItems )
+  {
+    auto array = mp_obj_malloc( mp_obj_array_t, &mp_type_array );
+    array->typecode = BufferTypeCode< T >::value;
+    array->free = 0;
+    array->len = numItems;
+    array->items = m_new( byte, numItems * sizeof( T ) );
+    if( numItems )
+    {
+      std::memcpy( array->items, items, numItems * sizeof( T ) );
+    }
+    return MP_OBJ_FROM_PTR( array );
+  }
+
+  template< class T, class Alloc >
+  struct ToPyObj< AsArray< std::vector< T, Alloc > > > : std::true_type
+  {
+    static mp_obj_t Convert( const AsArray< std::vector< T, Alloc > >& a )
+    {
+      return NewArray( a.value.data(), a.value.size() );
+    }
+  };
+#endif
+
+  template< class T, class Alloc >
+  struct ToPyObj< AsByteArray< std::vector< T, Alloc > > > : std::true_type
+  {
+    static_assert( sizeof( T ) == 1 && std::is_integral< T >::value, "AsByteArray requires a vector of bytes" );
+
+    static mp_obj_t Convert( const AsByteArray< std::vector< T, Alloc > >& a )
+    {
+      return mp_obj_new_bytearray( a.value.size(), a.value.data() );
+    }
+  };
+
+  template< class T, std::size_t N >
+  struct ToPyObj< std::array< T, N > > : std::true_type
+  {
+    static mp_obj_t Convert( const std::array< T, N >& a )
+    {
+      return ConvertToList( a.cbegin(), N, SelectToPyObj< T >::type::Convert );
+    }
+  };
+
+  template< class T, class Alloc >
+  struct ToPyObj< std::deque< T, Alloc > > : std::true_type
+  {
+    static mp_obj_t Convert( const std::deque< T, Alloc >& a )
+    {
+      return ConvertToList( a.cbegin(), a.size(), SelectToPyObj< T >::type::Convert );
+    }
+  };
+
+  template< class T, class Alloc >
+  struct ToPyObj< std::list< T, Alloc > > : std::true_type
   {
-    static mp_obj_t Convert( const std::vector< T >& a )
+    static mp_obj_t Convert( const std::list< T, Alloc >& a )
     {
       return ConvertToList( a.cbegin(), a.size(), SelectToPyObj< T >::type::Convert );
     }
   };
 
-  template< class K, class V >
-  struct ToPyObj< std::map< K, V > > : std::true_type
+  //Conversion of dict keys: same as for any other object, except for strings.
+  template< class K >
+  struct ToPyDictKey
   {
-    static mp_obj_t Convert( const std::map< K, V >& a )
+    static mp_obj_t Convert( const K& a )
     {
-      const auto numItems = a.size();
-      auto dict = mp_obj_new_dict( numItems );
-      std::for_each( a.cbegin(), a.cend(), [&dict] ( decltype( *a.cbegin() )& p )
+      return SelectToPyObj< K >::type::Convert( a );
+    }
+  };
+
+  //String keys which already exist as qstr (attribute names, keyword arguments, ...) become qstr objects:
+  //that doesn't allocate a str object, the hash is already known, and as long as all keys are qstrs
+  //the map stays flagged as such so lookups in it are plain qstr comparisons.
+  //Strings which don't exist as qstr are not interned: that would leak them into the qstr pool.
+  template< class Tr, class Alloc >
+  struct ToPyDictKey< std::basic_string< char, Tr, Alloc > >
+  {
+    static mp_obj_t Convert( const std::basic_string< char, Tr, Alloc >& a )
+    {
+      const auto q = qstr_find_strn( a.data(), a.length() );
+      if( q != MP_QSTRnull )
       {
-        mp_obj_dict_store( dict, SelectToPyObj< K >::type::Convert( p.first ), SelectToPyObj< V >::type::Convert( p.second ) );
-      } );
-      return dict;
+        return MP_OBJ_NEW_QSTR( q );
+      }
+      return ToPyObj< std::basic_string< char, Tr, Alloc > >::Convert( a );
     }
   };
 
+  //Generic conversion of pair of iterators over key/value pairs to uPy dict.
+  //The dict gets allocated once, with some room to spare: its table uses linear probing
+  //so completely filling it would make both these insertions and later lookups slow.
+  //Items are added to the dict's map directly, there's no need for mp_obj_dict_store's checks.
+  template< class K, class V, class It >
+  mp_obj_t ConvertToDict( It begin, It end, size_t numItems )
+  {
+    auto dict = mp_obj_new_dict( numItems + numItems / 2 );
+    auto map = mp_obj_dict_get_map( dict );
+    std::for_each( begin, end, [map] ( decltype( *begin )& p )
+    {
+      const auto key = ToPyDictKey< K >::Convert( p.first );
+      const auto value = SelectToPyObj< V >::type::Convert( p.second );
+      mp_map_lookup( map, key, MP_MAP_LOOKUP_ADD_IF_NOT_FOUND )->value = value;
+    } );
+    return dict;
+  }
+
+  template< class K, class V, class Cmp, class Alloc >
+  struct ToPyObj< std::map< K, V, Cmp, Alloc > > : std::true_type
+  {
+    static mp_obj_t Convert( const std::map< K, V, Cmp, Alloc >& a )
+    {
+      return ConvertToDict< K, V >( a.cbegin(), a.cend(), a.size() );
+    }
+  };
+
+  template< class K, class V, class Hash, class Eq, class Alloc >
+  struct ToPyObj< std::unordered_map< K, V, Hash, Eq, Alloc > > : std::true_type
+  {
+    static mp_obj_t Convert( const std::unordered_map< K, V, Hash, Eq, Alloc >& a )
+    {
+      return ConvertToDict< K, V >( a.cbegin(), a.cend(), a.size() );
+    }
+  };
+
+#if MICROPY_PY_BUILTINS_SET
+  //Generic conversion of pair of iterators to uPy set: the items are first converted into
+  //a temporary array on the uPy heap (so the GC sees them) which allows creating the set
+  //with the correct size in one go.
+  template< class It, class Transform >
+  mp_obj_t ConvertToSet( It begin, size_t numItems, Transform transform )
+  {
+    auto items = m_new( mp_obj_t, numItems );
+    std::transform( begin, std::next( begin, numItems ), items, transform );
+    auto set = mp_obj_new_set( numItems, items );
+    m_del( mp_obj_t, items, numItems );
+    return set;
+  }
+
+  template< class T, class Cmp, class Alloc >
+  struct ToPyObj< std::set< T, Cmp, Alloc > > : std::true_type
+  {
+    static mp_obj_t Convert( const std::set< T, Cmp, Alloc >& a )
+    {
+      return ConvertToSet( a.cbegin(), a.size(), SelectToPyObj< T >::type::Convert );
+    }
+  };
+
+  template< class T, class Hash, class Eq, class Alloc >
+  struct ToPyObj< std::unordered_set< T, Hash, Eq, Alloc > > : std::true_type
+  {
+    static mp_obj_t Convert( const std::unordered_set< T, Hash, Eq, Alloc >& a )
+    {
+      return ConvertToSet( a.cbegin(), a.size(), SelectToPyObj< T >::type::Convert );
+    }
+  };
+#endif
+
   namespace detail
   {
     struct AddConvertedToVec
@@ -361,6 +602,14 @@ namespace upywrap
     return SelectToPyObj< T >::type::Convert( arg );
   }
 
+  //Temporaries, typically return values, are moved: conversions taking their argument by value
+  //can then take over what it holds instead of copying it, see e.g. OwnedBuffer.
+  template< class T >
+  mp_obj_t ToPy( T&& arg, typename std::enable_if< !std::is_reference< T >::value && ToPyObj< T >::value >::type* = nullptr )
+  {
+    return SelectToPyObj< T >::type::Convert( std::move( arg ) );
+  }
+
 #if UPYWRAP_USE_CHARSTRING
   inline mp_obj_t ToPy( const char* arg )
   {
@@ -21,6 +21,13 @@ namespace upywrap
   //wrap.Def< Funcs::Foo >( Foo );
   //wrap.Def< Funcs::Bar >( Bar, Kwargs( "c", "str" );
   //
+  //With C++17 the function can also be passed as template argument:
+  //
+  //wrap.Def< Funcs::Foo, Foo >();
+  //
+  //which doesn't need to store the function so is faster to call, but does not support
+  //a return value converter.
+  //
   //This will register given functions in dict,
   //so if dict is the global dict of a module "mod"
   //the functions can be used in uPy like this:
@@ -51,7 +58,7 @@ namespace upywrap
       auto callerObject = call_type::CreateCaller( f );
       callerObject->convert_retval = conv;
       callerObject->arguments = std::move( arguments );
-      functionPointers[ (void*) name ] = callerObject;
+      call_type::Caller() = callerObject;
       mp_obj_dict_store( globals, new_qstr( name() ), call_type::CreateUPyFunction( *callerObject ) );
     }
 
@@ -61,7 +68,24 @@ namespace upywrap
       Def< name, Ret, A... >( f, Arguments(), conv );
     }
 
+#if UPYWRAP_HAS_CPP17
+    template< index_type name, auto f >
+    void Def( Arguments arguments = Arguments() )
+    {
+      DefBound< name, f >( f, std::move( arguments ) );
+    }
+#endif
+
   private:
+#if UPYWRAP_HAS_CPP17
+    template< index_type name, auto f, class Ret, class... A >
+    void DefBound( Ret ( * )( A... ), Arguments&& arguments )
+    {
+      typedef NativeBoundCall< name, BoundFunctionCall< f, Ret, A... >, Ret, A... > call_type;
+      mp_obj_dict_store( globals, new_qstr( name() ), call_type::CreateUPyFunction( std::move( arguments ) ) );
+    }
+#endif
+
     //wrap native call in function with uPy compatible mp_obj_t( mp_obj_t.... ) signature
     template< index_type index, class Ret, class... A >
     struct NativeCall
@@ -74,6 +98,14 @@ namespace upywrap
         return new call_type( f );
       }
 
+      //Each instantiation is unique for the given name and signature so it can own
+      //its caller object, which means calling doesn't require any lookup.
+      static call_type*& Caller()
+      {
+        static call_type* caller = nullptr;
+        return caller;
+      }
+
       static mp_obj_t CreateUPyFunction( const call_type& caller )
       {
         if( caller.arguments.HasArguments() )
@@ -89,7 +121,7 @@ namespace upywrap
 
       static mp_obj_t Call( typename project2nd< A, mp_obj_t >::type... args )
       {
-        auto f = (call_type*) FunctionWrapper::functionPointers[ (void*) index ];
+        auto f = Caller();
         return CallReturn< Ret, A... >::Call( f, args... );
       }
 
@@ -99,13 +131,13 @@ namespace upywrap
         {
           RaiseTypeException( "Wrong number of arguments" );
         }
-        auto f = (call_type*) FunctionWrapper::functionPointers[ (void*) index ];
+        auto f = Caller();
         return CallVar( f, args, make_index_sequence< sizeof...( A ) >() );
       }
 
       static mp_obj_t CallKw( size_t n_args, const mp_obj_t* pos_args, mp_map_t* kw_args )
       {
-        auto f = (call_type*) FunctionWrapper::functionPointers[ (void*) index ];
+        auto f = Caller();
         Arguments::parsed_obj_t parsedArgs{};
         f->arguments.Parse( n_args, pos_args, kw_args, parsedArgs );
         return CallVar( f, parsedArgs.data(), make_index_sequence< sizeof...( A ) >() );
@@ -119,16 +151,65 @@ namespace upywrap
       }
     };
 
-    mp_obj_dict_t* globals;
-    static function_ptrs functionPointers;
-  };
+#if UPYWRAP_HAS_CPP17
+    //Same as NativeCall but for functions known at compile-time.
+    template< index_type index, class Fun, class Ret, class... A >
+    struct NativeBoundCall
+    {
+      //Only allocated when keyword arguments are used.
+      static Arguments*& KwArguments()
+      {
+        static Arguments* arguments = nullptr;
+        return arguments;
+      }
+
+      static mp_obj_t CreateUPyFunction( Arguments&& arguments )
+      {
+        if( arguments.HasArguments() )
+        {
+          if( arguments.NumberOfArguments() != sizeof...( A ) )
+          {
+            RaiseTypeException( ( std::string( "Wrong number of arguments in definition of " ) + index() ).data()  );
+          }
+          const auto minNumArgs = arguments.MimimumNumberOfArguments();
+          KwArguments() = new Arguments( std::move( arguments ) );
+          return MakeFunction( minNumArgs, CallKw );
+        }
+        return CreateFunction< A... >::Create( Call, CallN );
+      }
+
+      static mp_obj_t Call( typename project2nd< A, mp_obj_t >::type... args )
+      {
+        return BoundCallReturn< Ret, A... >::template Call< Fun >( args... );
+      }
+
+      static mp_obj_t CallN( mp_uint_t nargs, const mp_obj_t* args )
+      {
+        if( nargs != sizeof...( A ) )
+        {
+          RaiseTypeException( "Wrong number of arguments" );
+        }
+        return CallVar( args, make_index_sequence< sizeof...( A ) >() );
+      }
 
-  //we want a header only library but that yields multiply defined symbols when including this file more then once
-  //so as a simple hack: define MMICROPYTHON_WRAP_FUNCTIONWRAPPER_DEFINED in all but one include location
-#ifndef MICROPYTHON_WRAP_FUNCTIONWRAPPER_DEFINED
-  function_ptrs FunctionWrapper::functionPointers;
+      static mp_obj_t CallKw( size_t n_args, const mp_obj_t* pos_args, mp_map_t* kw_args )
+      {
+        Arguments::parsed_obj_t parsedArgs{};
+        KwArguments()->Parse( n_args, pos_args, kw_args, parsedArgs );
+        return CallVar( parsedArgs.data(), make_index_sequence< sizeof...( A ) >() );
+      }
+
+      template< size_t... Indices >
+      static mp_obj_t CallVar( const mp_obj_t* args, index_sequence< Indices... > )
+      {
+        (void) args;
+        return BoundCallReturn< Ret, A... >::template Call< Fun >( args[ Indices ]... );
+      }
+    };
 #endif
 
+    mp_obj_dict_t* globals;
+  };
 }
 
 #endif //#ifndef MICROPYTHON_WRAP_FUNCTIONWRAPPER
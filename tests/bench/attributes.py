@@ -0,0 +1,31 @@
+# Attribute access on wrapped objects: getters, setters and method lookup
+# all go through the type's attr slot.
+import bench
+import upywraptest
+
+N = 100000
+
+def property_read(n):
+  s = upywraptest.Simple(0)
+  for i in range(n):
+    s.val
+
+def property_write(n):
+  s = upywraptest.Simple(0)
+  for i in range(n):
+    s.val = i
+
+def method_lookup(n):
+  s = upywraptest.Simple(0)
+  for i in range(n):
+    s.Value
+
+def class_variable(n):
+  s = upywraptest.Simple(0)
+  for i in range(n):
+    s.x
+
+bench.run('property read', property_read, N)
+bench.run('property write', property_write, N)
+bench.run('method lookup', method_lookup, N)
+bench.run('class variable', class_variable, N)
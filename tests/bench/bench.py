@@ -0,0 +1,10 @@
+# Helper for the timing scripts in this directory. These are not tests: the numbers
+# differ per machine and per run, so compare them between builds on the same machine.
+import time
+
+def run(name, fun, n):
+  fun(1)  # warm up, e.g. so one-time initialisation isn't timed
+  start = time.ticks_us()
+  fun(n)
+  elapsed = time.ticks_diff(time.ticks_us(), start)
+  print('{}: {} us total, {:.3f} us per iteration'.format(name, elapsed, elapsed / n))
@@ -0,0 +1,20 @@
+# Passing objects with the buffer protocol to functions taking std::vector,
+# compared with passing the same values as a list.
+from array import array
+import bench
+import upywraptest
+
+def calls(fun, arg):
+  def loop(n):
+    for i in range(n):
+      fun(arg)
+  return loop
+
+for size in (1000, 100000, 1000000):
+  n = max(10, 1000000 // size)
+  floats = array('f', range(size))
+  bench.run('{} floats from array'.format(size), calls(upywraptest.SumFloats, floats), n)
+  bench.run('{} bytes from bytearray'.format(size), calls(upywraptest.SumBytes, bytearray(size)), n)
+  floats = list(floats)
+  bench.run('{} floats from list'.format(size), calls(upywraptest.SumFloats, floats), n)
+  floats = None
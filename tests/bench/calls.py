@@ -0,0 +1,44 @@
+# Overhead of calling wrapped functions, which is dominated by the dispatch
+# to the native function and argument conversion.
+import bench
+import upywraptest
+
+N = 100000
+
+def module_function(n):
+  f = upywraptest.HasExceptions
+  for i in range(n):
+    f()
+
+def method_no_args(n):
+  s = upywraptest.Simple(0)
+  for i in range(n):
+    s.Value()
+
+def method_one_arg(n):
+  s = upywraptest.Simple(0)
+  for i in range(n):
+    s.Add(1)
+
+def bound_method(n):
+  s = upywraptest.Simple(0)
+  for i in range(n):
+    s.BoundAdd(1)
+
+# Calling a method of a type with n registered methods: the cost should not depend on n.
+def registry_method(registry, name):
+  def loop(n):
+    o = registry()
+    f = getattr(o, name)
+    for i in range(n):
+      f()
+  return loop
+
+bench.run('module function', module_function, N)
+bench.run('method without arguments', method_no_args, N)
+bench.run('method with argument', method_one_arg, N)
+bench.run('bound method', bound_method, N)
+for size in (10, 100, 1000):
+  registry = getattr(upywraptest, 'Registry{}'.format(size))
+  bench.run('first of {} methods'.format(size), registry_method(registry, 'f0'), N)
+  bench.run('last of {} methods'.format(size), registry_method(registry, 'f{}'.format(size - 1)), N)
@@ -0,0 +1,30 @@
+# Garbage collection of wrapped objects: Point is stored inline and trivially destructible
+# so allocated without finaliser, Simple is held by a shared_ptr which the finaliser releases.
+import gc
+import time
+import bench
+import upywraptest
+
+SIZE = 100000
+N = 10
+
+def collect(n):
+  for i in range(n):
+    gc.collect()
+
+def sweep(name, make):
+  elapsed = 0
+  for i in range(N):
+    objects = [make(j) for j in range(SIZE)]
+    objects = None
+    start = time.ticks_us()
+    gc.collect()
+    elapsed += time.ticks_diff(time.ticks_us(), start)
+  print('{}: {} us total, {:.3f} us per iteration'.format(name, elapsed, elapsed / N))
+
+for name, make in (('Point', lambda i: upywraptest.Point(i, i)), ('Simple', upywraptest.Simple)):
+  gc.collect()
+  objects = [make(i) for i in range(SIZE)]
+  bench.run('gc.collect with {} live {}'.format(SIZE, name), collect, N)
+  objects = None
+  sweep('gc.collect freeing {} {}'.format(SIZE, name), make)
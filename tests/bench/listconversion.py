@@ -0,0 +1,20 @@
+# Passing lists of numbers to functions taking std::vector.
+import bench
+import upywraptest
+
+SIZE = 10000
+N = 1000
+
+def calls(fun, arg):
+  def loop(n):
+    for i in range(n):
+      fun(arg)
+  return loop
+
+ints = list(range(SIZE))
+bench.run('{} small ints to int'.format(SIZE), calls(upywraptest.SumInts, ints), N)
+bench.run('{} small ints to int64_t'.format(SIZE), calls(upywraptest.SumInt64, ints), N)
+bench.run('{} small ints to float'.format(SIZE), calls(upywraptest.SumFloats, ints), N)
+bench.run('{} floats to float'.format(SIZE), calls(upywraptest.SumFloats, [i * 0.5 for i in ints]), N)
+# A single big int means every item goes through the per-item conversion.
+bench.run('{} ints of which one big to int64_t'.format(SIZE), calls(upywraptest.SumInt64, ints + [2 ** 40]), N)
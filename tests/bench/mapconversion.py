@@ -0,0 +1,18 @@
+# Passing large dicts to functions taking std::map or std::unordered_map and returning them.
+import bench
+import upywraptest
+
+SIZE = 20000
+N = 20
+
+def calls(fun, arg):
+  def loop(n):
+    for i in range(n):
+      fun(arg)
+  return loop
+
+ints = {i: str(i) for i in range(SIZE)}
+strings = {'key{}'.format(i): i for i in range(SIZE)}
+bench.run('{} int keys, std::map both ways'.format(SIZE), calls(upywraptest.MapCopy, ints), N)
+bench.run('{} str keys, std::map both ways'.format(SIZE), calls(upywraptest.MapStringKeysCopy, strings), N)
+bench.run('{} str keys, std::unordered_map both ways'.format(SIZE), calls(upywraptest.UnorderedMap, strings), N)
@@ -0,0 +1,17 @@
+# Returning integer vectors, converted into lists.
+import bench
+import upywraptest
+
+def calls(fun, start, size):
+  def loop(n):
+    for i in range(n):
+      fun(start, size)
+  return loop
+
+for size in (1000, 1000000):
+  n = max(5, 1000000 // size)
+  bench.run('{} int32_t'.format(size), calls(upywraptest.IotaInt32, 0, size), n)
+  bench.run('{} uint64_t'.format(size), calls(upywraptest.IotaUnsigned64, 0, size), n)
+  # Too large for small ints so every item has to be allocated: limited in size to fit the heap.
+  size = min(size, 100000)
+  bench.run('{} uint64_t from 2 ** 63'.format(size), calls(upywraptest.IotaUnsigned64, 2 ** 63, size), n)
@@ -0,0 +1,102 @@
+#ifndef MICROPYTHON_WRAP_TESTS_BUFFER_H
+#define MICROPYTHON_WRAP_TESTS_BUFFER_H
+
+#include "../detail/buffer.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+#if UPYWRAP_HAS_CPP20
+#include <span>
+#endif
+
+namespace upywrap
+{
+  class FloatBuffer
+  {
+  public:
+    FloatBuffer( std::size_t size ) :
+      values( size, 0.0f )
+    {
+    }
+
+    float* Data()
+    {
+      return values.data();
+    }
+
+    std::size_t Size() const
+    {
+      return values.size();
+    }
+
+    double Sum() const
+    {
+      return std::accumulate( values.cbegin(), values.cend(), 0.0 );
+    }
+
+  private:
+    std::vector< float > values;
+  };
+
+  class ConstBytes
+  {
+  public:
+    ConstBytes() :
+      values{ 1, 2, 3 }
+    {
+    }
+
+    const std::uint8_t* Data() const
+    {
+      return values.data();
+    }
+
+    std::size_t Size() const
+    {
+      return values.size();
+    }
+
+  private:
+    std::vector< std::uint8_t > values;
+  };
+
+  double SumView( BufferView< const float > values )
+  {
+    return std::accumulate( values.begin(), values.end(), 0.0 );
+  }
+
+  void FillView( BufferView< std::uint8_t > values, std::uint8_t value )
+  {
+    std::fill( values.begin(), values.end(), value );
+  }
+
+  OwnedBuffer< std::vector< float > > MakeFloats( std::size_t size )
+  {
+    std::vector< float > values( size );
+    std::iota( values.begin(), values.end(), 0.0f );
+    return values;
+  }
+
+  //Returned by reference so converting it must copy instead of taking over the data.
+  const OwnedBuffer< std::vector< float > >& StoredFloats()
+  {
+    static const OwnedBuffer< std::vector< float > > floats( std::vector< float >{ 1.0f, 2.0f } );
+    return floats;
+  }
+
+#if UPYWRAP_HAS_CPP20
+  double SumSpan( std::span< const float > values )
+  {
+    return std::accumulate( values.begin(), values.end(), 0.0 );
+  }
+
+  void FillSpan( std::span< std::uint8_t > values, std::uint8_t value )
+  {
+    std::fill( values.begin(), values.end(), value );
+  }
+#endif
+}
+
+#endif //#ifndef MICROPYTHON_WRAP_TESTS_BUFFER_H
@@ -1,9 +1,12 @@
 #ifndef MICROPYTHON_WRAP_TESTS_CLASS_H
 #define MICROPYTHON_WRAP_TESTS_CLASS_H
 
+#include <cstdint>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <string>
+#include <tuple>
 
 namespace upywrap
 {
@@ -145,6 +148,150 @@ namespace upywrap
   private:
     std::vector< simple_t > simples;
   };
+
+  //Value-like type stored in its uPy object.
+  class Point
+  {
+  public:
+    Point( double x, double y ) :
+      x( x ),
+      y( y )
+    {
+    }
+
+    double X() const
+    {
+      return x;
+    }
+
+    double Y() const
+    {
+      return y;
+    }
+
+    void Move( double dx, double dy )
+    {
+      x += dx;
+      y += dy;
+    }
+
+    Point Scaled( double f ) const
+    {
+      return Point( x * f, y * f );
+    }
+
+    bool IsAligned() const
+    {
+      return reinterpret_cast< std::uintptr_t >( this ) % alignof( Point ) == 0;
+    }
+
+    std::string Str() const
+    {
+      return "Point " + std::to_string( x ) + " " + std::to_string( y );
+    }
+
+  private:
+    double x;
+    double y;
+  };
+
+  template<>
+  struct InlineStorage< Point > : std::true_type
+  {
+  };
+
+  Point Midpoint( const Point& a, const Point& b )
+  {
+    return Point( ( a.X() + b.X() ) / 2, ( a.Y() + b.Y() ) / 2 );
+  }
+
+  Point& MovedPoint( Point& p, double d )
+  {
+    p.Move( d, d );
+    return p;
+  }
+
+  std::shared_ptr< Point > SharedPoint( std::shared_ptr< Point > p )
+  {
+    return p;
+  }
+
+  //Short-lived type which gets its memory from a pool.
+  class Pooled
+  {
+  public:
+    Pooled( int a ) :
+      a( a )
+    {
+    }
+
+    int Value() const
+    {
+      return a;
+    }
+
+    Pooled Plus( int b ) const
+    {
+      return Pooled( a + b );
+    }
+
+  private:
+    int a;
+  };
+
+  template<>
+  struct PoolSize< Pooled > : std::integral_constant< std::size_t, 4 >
+  {
+  };
+
+  std::shared_ptr< Pooled > MakePooled( int a )
+  {
+    return std::allocate_shared< Pooled >( PoolAllocator< Pooled >(), a );
+  }
+
+  std::tuple< std::size_t, std::size_t, std::size_t > PoolCounters()
+  {
+    const auto& stats = ClassWrapper< Pooled >::PoolStatistics();
+    return std::make_tuple( stats.hits, stats.misses, stats.size );
+  }
+
+  //Type of which the destructor doesn't run during garbage collection.
+  class Deferred
+  {
+  public:
+    ~Deferred()
+    {
+      ++NumDestroyed();
+    }
+
+    static int& NumDestroyed()
+    {
+      static int n = 0;
+      return n;
+    }
+  };
+
+  template<>
+  struct DestructionMode< Deferred > : std::integral_constant< Destruction, Destruction::Deferred >
+  {
+  };
+
+  int DeferredDestroyed()
+  {
+    return Deferred::NumDestroyed();
+  }
+
+  //Heap bytes per instance, and what the native part of that takes.
+  std::map< std::string, std::size_t > InstanceSizes()
+  {
+    return {
+      { "base", sizeof( mp_obj_base_t ) },
+      { "Simple", ClassWrapper< Simple >::InstanceSize() },
+      { "SimpleObj", sizeof( ClassWrapper< Simple >::native_obj_t ) },
+      { "Point", ClassWrapper< Point >::InstanceSize() },
+      { "PointObj", sizeof( Point ) }
+    };
+  }
 }
 
 #endif //#ifndef MICROPYTHON_WRAP_TESTS_CLASS_H
@@ -0,0 +1,109 @@
+#ifndef MICROPYTHON_WRAP_TESTS_CONTAINERS_H
+#define MICROPYTHON_WRAP_TESTS_CONTAINERS_H
+
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <list>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace upywrap
+{
+  auto UnorderedMap( std::unordered_map< std::string, int > x ) -> decltype( x )
+  {
+    x[ "size" ] = static_cast< int >( x.size() );
+    return x;
+  }
+
+  auto Set( std::set< int > x ) -> decltype( x )
+  {
+    x.insert( -1 );
+    return x;
+  }
+
+  auto UnorderedSet( std::unordered_set< std::string > x ) -> decltype( x )
+  {
+    x.insert( "x" );
+    return x;
+  }
+
+  auto Deque( std::deque< int > x ) -> decltype( x )
+  {
+    x.push_front( 0 );
+    return x;
+  }
+
+  auto List( std::list< std::string > x ) -> decltype( x )
+  {
+    x.reverse();
+    return x;
+  }
+
+  auto Array3( std::array< double, 3 > x ) -> decltype( x )
+  {
+    std::reverse( x.begin(), x.end() );
+    return x;
+  }
+
+  double SumIterable( Iterable< double > items )
+  {
+    double sum = 0.0;
+    for( auto item : items )
+    {
+      sum += item;
+    }
+    return sum;
+  }
+
+  std::vector< std::string > TakeFromIterable( Iterable< std::string > items, int n )
+  {
+    std::vector< std::string > ret;
+    for( auto it = items.begin() ; n > 0 && it != items.end() ; --n )
+    {
+      ret.push_back( *it++ );
+    }
+    return ret;
+  }
+
+  class Samples : public std::enable_shared_from_this< Samples >
+  {
+  public:
+    Samples( int n ) :
+      values( static_cast< std::size_t >( n ) )
+    {
+      std::iota( values.begin(), values.end(), 0 );
+      for( auto i : values )
+      {
+        names[ "s" + std::to_string( i ) ] = i;
+      }
+    }
+
+    ContainerView< std::vector< int > > Values()
+    {
+      return ContainerView< std::vector< int > >( shared_from_this(), values );
+    }
+
+    ContainerView< std::map< std::string, int > > Names()
+    {
+      return ContainerView< std::map< std::string, int > >( shared_from_this(), names );
+    }
+
+  private:
+    std::vector< int > values;
+    std::map< std::string, int > names;
+  };
+
+  ContainerView< std::list< std::string > > ListView()
+  {
+    return std::make_shared< const std::list< std::string > >( std::list< std::string >{ "a", "b", "c" } );
+  }
+}
+
+#endif //#ifndef MICROPYTHON_WRAP_TESTS_CONTAINERS_H
@@ -0,0 +1,45 @@
+#ifndef MICROPYTHON_WRAP_TESTS_GENERATOR_H
+#define MICROPYTHON_WRAP_TESTS_GENERATOR_H
+
+#include <stdexcept>
+#include <string>
+
+namespace upywrap
+{
+  Generator< int > Range( int n )
+  {
+    for( int i = 0 ; i < n ; ++i )
+    {
+      co_yield i;
+    }
+  }
+
+  Generator< std::string > Words( std::string s )
+  {
+    std::string word;
+    for( auto c : s )
+    {
+      if( c == ' ' )
+      {
+        co_yield word;
+        word.clear();
+      }
+      else
+      {
+        word += c;
+      }
+    }
+    co_yield word;
+  }
+
+  Generator< int > ThrowAfter( int n )
+  {
+    for( int i = 0 ; i < n ; ++i )
+    {
+      co_yield i;
+    }
+    throw std::runtime_error( "done" );
+  }
+}
+
+#endif //#ifndef MICROPYTHON_WRAP_TESTS_GENERATOR_H
@@ -2,6 +2,7 @@
 #define MICROPYTHON_WRAP_TESTS_MAP_H
 
 #include <algorithm>
+#include <functional>
 #include <iostream>
 #include <map>
 #include <vector>
@@ -21,6 +22,30 @@ namespace upywrap
     std::cout << std::endl;
     return x;
   }
+
+  auto MapCopy( std::map< int, std::string > x ) -> decltype( x )
+  {
+    return x;
+  }
+
+  auto MapStringKeysCopy( std::map< std::string, int > x ) -> decltype( x )
+  {
+    return x;
+  }
+
+  std::vector< int > MapDescendingValues( std::map< int, int, std::greater< int > > x )
+  {
+    std::vector< int > values;
+    std::for_each( x.cbegin(), x.cend(), [&values] ( decltype( *x.cend() ) i ) { values.push_back( i.second ); } );
+    return values;
+  }
+
+  auto MapDescending( std::map< std::string, int, std::greater< std::string > > x ) -> decltype( x )
+  {
+    std::for_each( x.cbegin(), x.cend(), [] ( decltype( *x.cend() ) i ) { std::cout << i.first << i.second; } );
+    std::cout << std::endl;
+    return x;
+  }
 }
 
 #endif //#ifndef MICROPYTHON_WRAP_TESTS_MAP_H
@@ -6,6 +6,7 @@
 #include "map.h"
 #include "function.h"
 #include "tuple.h"
+#include "containers.h"
 #include "vector.h"
 #include "class.h"
 #include "context.h"
@@ -14,12 +15,21 @@
 #include "qualifier.h"
 #include "nargs.h"
 #include "numeric.h"
+#include "operators.h"
+#include "buffer.h"
+#include "registry.h"
 #if UPYWRAP_HAS_CPP17
 #include "optional.h"
 #endif
 #if UPYWRAP_THROW_ERROR_CODE
 #include "errorcode.h"
 #endif
+#if UPYWRAP_HAS_PMR
+#include "pmr.h"
+#endif
+#if UPYWRAP_HAS_COROUTINES
+#include "generator.h"
+#endif
 using namespace upywrap;
 
 struct F
@@ -29,6 +39,7 @@ struct F
   func_name_def( HasErrorCode )
   func_name_def( HasStringView )
   func_name_def( HasOptional )
+  func_name_def( HasBoundDef )
 
   func_name_def( __eq__ )
   func_name_def( __ne__ )
@@ -38,8 +49,35 @@ struct F
   func_name_def( Tuple2 )
   func_name_def( Vector1 )
   func_name_def( Vector2 )
+  func_name_def( VectorInt64 )
+  func_name_def( VectorUnsigned64 )
+  func_name_def( IotaInt32 )
+  func_name_def( IotaUnsigned64 )
+  func_name_def( VectorCustomAllocator )
+  func_name_def( SumBytes )
+  func_name_def( SumFloats )
+  func_name_def( SumInt64 )
+  func_name_def( SumInts )
+  func_name_def( FloatsAsArray )
+  func_name_def( IntsAsArray )
+  func_name_def( BytesAsByteArray )
   func_name_def( Map1 )
   func_name_def( Map2 )
+  func_name_def( UnorderedMap )
+  func_name_def( Set )
+  func_name_def( UnorderedSet )
+  func_name_def( Deque )
+  func_name_def( List )
+  func_name_def( Array3 )
+  func_name_def( Values )
+  func_name_def( Names )
+  func_name_def( ListView )
+  func_name_def( SumIterable )
+  func_name_def( TakeFromIterable )
+  func_name_def( MapDescending )
+  func_name_def( MapCopy )
+  func_name_def( MapStringKeysCopy )
+  func_name_def( MapDescendingValues )
   func_name_def( Func1 )
   func_name_def( Func2 )
   func_name_def( Func3 )
@@ -53,6 +91,20 @@ struct F
   func_name_def( ToFunc2 )
   func_name_def( ToFunc3 )
   func_name_def( IsNullPtr )
+  func_name_def( X )
+  func_name_def( Y )
+  func_name_def( Move )
+  func_name_def( Moved )
+  func_name_def( Scaled )
+  func_name_def( SharedPoint )
+  func_name_def( InstanceSizes )
+  func_name_def( PoolCounters )
+  func_name_def( MakePooled )
+  func_name_def( DeferredDestroyed )
+  func_name_def( DrainFinalizers )
+  func_name_def( PendingFinalizers )
+  func_name_def( IsAligned )
+  func_name_def( Midpoint )
   func_name_def( IsNullSharedPtr )
   func_name_def( IsEmptyFunction )
   func_name_def( CallbackWithNativeArg )
@@ -114,6 +166,33 @@ struct F
   func_name_def( NoErrorCode )
   func_name_def( SomeErrorCode )
 
+  func_name_def( BoundAdd )
+  func_name_def( BoundValue )
+  func_name_def( BoundPlus )
+  func_name_def( BoundSimpleFunc )
+  func_name_def( BoundFunc7 )
+  func_name_def( BoundEight )
+  func_name_def( BoundTwoKw )
+
+  func_name_def( Sum )
+  func_name_def( HasSpan )
+  func_name_def( SumView )
+  func_name_def( FillView )
+  func_name_def( SumSpan )
+  func_name_def( FillSpan )
+  func_name_def( MakeFloats )
+  func_name_def( StoredFloats )
+  func_name_def( HasPmr )
+  func_name_def( HasCoroutines )
+  func_name_def( Range )
+  func_name_def( Words )
+  func_name_def( ThrowAfter )
+  func_name_def( PmrStrings )
+  func_name_def( PmrMap )
+  func_name_def( PmrSplit )
+  func_name_def( PmrEcho )
+  func_name_def( PmrLengths )
+
   func_name_def( TestVariables )
   func_name_def( RunCppTests )
 };
@@ -181,12 +260,21 @@ extern "C"
     wrap1.StoreClassVariable( "x", 0 );
     wrap1.StoreClassVariable( "y", 0.0 );
     wrap1.StoreClassVariable( "z", std::string( "z" ) );
+#if UPYWRAP_HAS_CPP17
+    wrap1.Def< F::BoundAdd, &Simple::Add >();
+    wrap1.Def< F::BoundValue, &Simple::Value >();
+    wrap1.Def< F::BoundPlus, &Simple::Plus >( Kwargs( "rh" ) );
+    wrap1.Def< F::BoundSimpleFunc, SimpleFunc >();
+#endif
 
     upywrap::ClassWrapper< NewSimple > wrapNewSimple( "Simple2", mod );
     wrapNewSimple.DefInit( ConstructNewSimple );
     wrapNewSimple.Def< F::Value >( &NewSimple::Value );
     wrapNewSimple.Def< F::Name >( &NewSimple::Name );
     wrapNewSimple.Def< upywrap::special_methods::__str__ >( &NewSimple::Str );
+#if UPYWRAP_HAS_CPP17
+    wrapNewSimple.Def< F::BoundValue, &NewSimple::Value >();
+#endif
 
     upywrap::ClassWrapper< SharedSimple > wrapSharedSimple( "Simple3", mod );
     wrapSharedSimple.DefInit( ConstructSharedSimple );
@@ -198,6 +286,63 @@ extern "C"
     wrapSimpleCollection.Def< F::Get >( &SimpleCollection::At );
     wrapSimpleCollection.Def< F::Reference >( &SimpleCollection::RefCount );
 
+    upywrap::ClassWrapper< Point > point( "Point", mod );
+    point.DefInit< double, double >();
+    point.Def< F::X >( &Point::X );
+    point.Def< F::Y >( &Point::Y );
+    point.Def< F::Move >( &Point::Move );
+    point.Def< F::Moved >( MovedPoint );
+    point.Def< F::Scaled >( &Point::Scaled );
+    point.Def< F::IsAligned >( &Point::IsAligned );
+    point.Def< upywrap::special_methods::__str__ >( &Point::Str );
+
+    upywrap::ClassWrapper< Pooled > pooled( "Pooled", mod );
+    pooled.DefInit< int >();
+    pooled.Def< F::Value >( &Pooled::Value );
+    pooled.Def< F::Plus >( &Pooled::Plus );
+
+    upywrap::ClassWrapper< Deferred > deferred( "Deferred", mod );
+    deferred.DefInit<>();
+
+    upywrap::DefRegistry< 10 >( "Registry10", mod );
+    upywrap::DefRegistry< 100 >( "Registry100", mod );
+    upywrap::DefRegistry< 1000 >( "Registry1000", mod );
+
+    upywrap::ClassWrapper< Number > number( "Number", mod );
+    number.DefInit< int >();
+    number.Def< F::Value >( &Number::Value );
+    number.DefBinaryOp< MP_BINARY_OP_ADD >( AddNumbers );
+    number.DefBinaryOp< MP_BINARY_OP_SUBTRACT >( &Number::operator - );
+    number.DefBinaryOp< MP_BINARY_OP_MULTIPLY >( &Number::Multiply );
+    number.DefBinaryOp< MP_BINARY_OP_EQUAL >( &Number::operator == );
+    number.DefBinaryOp< MP_BINARY_OP_LESS >( &Number::operator < );
+    number.DefUnaryOp< MP_UNARY_OP_NEGATIVE >( &Number::operator - );
+    number.DefUnaryOp< MP_UNARY_OP_BOOL >( &Number::operator bool );
+    number.DefUnaryOp< MP_UNARY_OP_HASH >( &Number::Hash );
+
+    upywrap::ClassWrapper< Numbers > numbers( "Numbers", mod );
+    numbers.DefInit<>();
+    numbers.Def< F::Add >( &Numbers::Append );
+    numbers.DefUnaryOp< MP_UNARY_OP_LEN >( &Numbers::size );
+    numbers.DefGetItem( &Numbers::operator [] );
+    numbers.DefSetItem( &Numbers::Set );
+    numbers.DefDelItem( &Numbers::Erase );
+    numbers.DefIter( &Numbers::begin, &Numbers::end );
+
+    upywrap::ClassWrapper< Samples > samples( "Samples", mod );
+    samples.DefInit< int >();
+    samples.Def< F::Values >( &Samples::Values );
+    samples.Def< F::Names >( &Samples::Names );
+
+    upywrap::ClassWrapper< FloatBuffer > floatBuffer( "FloatBuffer", mod );
+    floatBuffer.DefInit< std::size_t >();
+    floatBuffer.Def< F::Sum >( &FloatBuffer::Sum );
+    floatBuffer.DefBuffer( &FloatBuffer::Data, &FloatBuffer::Size );
+
+    upywrap::ClassWrapper< ConstBytes > constBytes( "ConstBytes", mod );
+    constBytes.DefInit<>();
+    constBytes.DefBuffer( &ConstBytes::Data, &ConstBytes::Size );
+
     upywrap::ClassWrapper< Context > wrap2( "Context", mod );
     wrap2.DefInit<>();
     wrap2.DefExit( &Context::Dispose );
@@ -219,20 +364,72 @@ extern "C"
     kwargs.DefInit< int, const NativeThing&, int >( Kwargs( "a", 1 )( "b", std::make_shared< NativeThing >( 0 ) )( "c", 2 ) );
     kwargs.Def< F::TwoKw1 >( &KwargsTest::Two, Kwargs( "a" )( "b", 2 ) );
     kwargs.Def< F::TwoKw2 >( &KwargsTest::Two, Kwargs( "a", 1 )( "b", 2 ) );
+#if UPYWRAP_HAS_CPP17
+    kwargs.Def< F::BoundTwoKw, &KwargsTest::Two >( Kwargs( "a", 1 )( "b", 2 ) );
+#endif
 
     upywrap::FunctionWrapper fn( mod );
     fn.Def< F::HasExceptions >( HasExceptions );
     fn.Def< F::HasCharString >( HasCharString );
     fn.Def< F::HasErrorCode >( HasErrorCode );
     fn.Def< F::HasOptional >( HasOptional );
+    fn.Def< F::HasSpan >( HasSpan );
+    fn.Def< F::HasPmr >( HasPmr );
+    fn.Def< F::HasCoroutines >( HasCoroutines );
+#if UPYWRAP_HAS_COROUTINES
+    fn.Def< F::Range >( Range );
+    fn.Def< F::Words >( Words );
+    fn.Def< F::ThrowAfter >( ThrowAfter );
+#endif
+#if UPYWRAP_HAS_PMR
+    fn.Def< F::PmrStrings >( PmrStrings );
+    fn.Def< F::PmrMap >( PmrMap );
+    fn.Def< F::PmrSplit >( PmrSplit );
+    fn.Def< F::PmrEcho >( PmrEcho );
+    fn.Def< F::PmrLengths >( PmrLengths );
+#endif
+    fn.Def< F::HasBoundDef >( HasBoundDef );
     fn.Def< F::HasStringView >( HasStringView );
     fn.Def< F::Pair >( Pair );
     fn.Def< F::Tuple1 >( Tuple1 );
     fn.Def< F::Tuple2 >( Tuple2 );
     fn.Def< F::Vector1 >( Vector< int > );
     fn.Def< F::Vector2 >( Vector< std::string > );
+    fn.Def< F::VectorInt64 >( Vector< std::int64_t > );
+    fn.Def< F::VectorUnsigned64 >( Vector< std::uint64_t > );
+    fn.Def< F::IotaInt32 >( Iota< std::int32_t > );
+    fn.Def< F::IotaUnsigned64 >( Iota< std::uint64_t > );
+    fn.Def< F::VectorCustomAllocator >( VectorCustomAllocator );
+    fn.Def< F::SumBytes >( SumVector< std::uint8_t > );
+    fn.Def< F::SumFloats >( SumVector< float > );
+    fn.Def< F::SumInt64 >( SumVector< std::int64_t > );
+    fn.Def< F::SumInts >( SumVector< int > );
+    fn.Def< F::FloatsAsArray >( VectorAsArray< float > );
+    fn.Def< F::IntsAsArray >( VectorAsArray< int > );
+    fn.Def< F::BytesAsByteArray >( VectorAsByteArray );
+    fn.Def< F::SumView >( SumView );
+    fn.Def< F::FillView >( FillView );
+    fn.Def< F::MakeFloats >( MakeFloats );
+    fn.Def< F::StoredFloats >( StoredFloats );
+#if UPYWRAP_HAS_CPP20
+    fn.Def< F::SumSpan >( SumSpan );
+    fn.Def< F::FillSpan >( FillSpan );
+#endif
     fn.Def< F::Map1 >( Map1 );
     fn.Def< F::Map2 >( Map2 );
+    fn.Def< F::MapDescending >( MapDescending );
+    fn.Def< F::MapCopy >( MapCopy );
+    fn.Def< F::MapStringKeysCopy >( MapStringKeysCopy );
+    fn.Def< F::MapDescendingValues >( MapDescendingValues );
+    fn.Def< F::UnorderedMap >( UnorderedMap );
+    fn.Def< F::Set >( Set );
+    fn.Def< F::UnorderedSet >( UnorderedSet );
+    fn.Def< F::Deque >( Deque );
+    fn.Def< F::List >( List );
+    fn.Def< F::Array3 >( Array3 );
+    fn.Def< F::ListView >( ListView );
+    fn.Def< F::SumIterable >( SumIterable );
+    fn.Def< F::TakeFromIterable >( TakeFromIterable );
     fn.Def< F::Func1 >( Func1 );
     fn.Def< F::Func2 >( Func2 );
     fn.Def< F::Func3 >( Func3 );
@@ -247,6 +444,14 @@ extern "C"
     fn.Def< F::ToFunc3 >( ToFunc3 );
     fn.Def< F::IsNullPtr >( IsNullPtr );
     fn.Def< F::IsNullSharedPtr >( IsNullSharedPtr );
+    fn.Def< F::Midpoint >( Midpoint );
+    fn.Def< F::SharedPoint >( SharedPoint );
+    fn.Def< F::InstanceSizes >( InstanceSizes );
+    fn.Def< F::PoolCounters >( PoolCounters );
+    fn.Def< F::MakePooled >( MakePooled );
+    fn.Def< F::DeferredDestroyed >( DeferredDestroyed );
+    fn.Def< F::DrainFinalizers >( DrainFinalizers );
+    fn.Def< F::PendingFinalizers >( PendingFinalizers );
     fn.Def< F::IsEmptyFunction >( IsEmptyFunction );
     fn.Def< F::CallbackWithNativeArg >( CallbackWithNativeArg );
     fn.Def< F::BuiltinValue >( BuiltinValue );
@@ -299,6 +504,12 @@ extern "C"
     fn.Def< F::OptionalArgument >( OptionalArgument );
 #endif
 
+#if UPYWRAP_HAS_CPP17
+    fn.Def< F::BoundFunc7, Func7 >();
+    fn.Def< F::BoundEight, Eight >();
+    fn.Def< F::BoundTwoKw, Two >( Kwargs( "a" )( "b", 2 ) );
+#endif
+
 #if UPYWRAP_THROW_ERROR_CODE
     fn.Def< F::NoErrorCode >( NoErrorCode );
     fn.Def< F::SomeErrorCode >( SomeErrorCode );
@@ -0,0 +1,115 @@
+#ifndef MICROPYTHON_WRAP_TESTS_OPERATORS_H
+#define MICROPYTHON_WRAP_TESTS_OPERATORS_H
+
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace upywrap
+{
+  class Number
+  {
+  public:
+    Number( int value ) :
+      value( value )
+    {
+    }
+
+    int Value() const
+    {
+      return value;
+    }
+
+    bool operator == ( const Number& rh ) const
+    {
+      return value == rh.value;
+    }
+
+    bool operator < ( const Number& rh ) const
+    {
+      return value < rh.value;
+    }
+
+    int operator - ( const Number& rh ) const
+    {
+      return value - rh.value;
+    }
+
+    int operator - () const
+    {
+      return -value;
+    }
+
+    explicit operator bool() const
+    {
+      return value != 0;
+    }
+
+    std::size_t Hash() const
+    {
+      return static_cast< std::size_t >( value ) * 2u;
+    }
+
+    std::shared_ptr< Number > Multiply( int factor )
+    {
+      return std::make_shared< Number >( value * factor );
+    }
+
+  private:
+    int value;
+  };
+
+  std::shared_ptr< Number > AddNumbers( const Number& a, const Number& b )
+  {
+    return std::make_shared< Number >( a.Value() + b.Value() );
+  }
+
+  class Numbers
+  {
+  public:
+    void Append( int value )
+    {
+      values.push_back( value );
+    }
+
+    std::size_t size() const
+    {
+      return values.size();
+    }
+
+    int operator [] ( std::size_t i ) const
+    {
+      return values.at( i );
+    }
+
+    void Set( std::size_t i, int value )
+    {
+      values.at( i ) = value;
+    }
+
+    void Erase( std::size_t i )
+    {
+      if( i >= values.size() )
+      {
+        throw std::out_of_range( "index out of range" );
+      }
+      values.erase( values.begin() + i );
+    }
+
+    std::vector< int >::const_iterator begin() const
+    {
+      return values.cbegin();
+    }
+
+    std::vector< int >::const_iterator end() const
+    {
+      return values.cend();
+    }
+
+  private:
+    std::vector< int > values;
+  };
+}
+
+#endif //#ifndef MICROPYTHON_WRAP_TESTS_OPERATORS_H
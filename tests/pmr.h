@@ -0,0 +1,56 @@
+#ifndef MICROPYTHON_WRAP_TESTS_PMR_H
+#define MICROPYTHON_WRAP_TESTS_PMR_H
+
+#include <cstddef>
+#include <map>
+#include <memory_resource>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace upywrap
+{
+  std::size_t PmrStrings( const std::pmr::vector< std::pmr::string >& strings )
+  {
+    return std::accumulate( strings.cbegin(), strings.cend(), std::size_t( 0 ),
+                            [] ( std::size_t sum, const std::pmr::string& s ) { return sum + s.size(); } );
+  }
+
+  int PmrMap( const std::pmr::map< std::pmr::string, std::pmr::vector< int > >& map )
+  {
+    int sum = 0;
+    for( const auto& kv : map )
+    {
+      sum += std::accumulate( kv.second.cbegin(), kv.second.cend(), 0 );
+    }
+    return sum;
+  }
+
+  //With UPYWRAP_SCRATCHARENA the argument, and so the return value, lives in the arena.
+  std::pmr::vector< std::pmr::string > PmrEcho( std::pmr::vector< std::pmr::string > strings )
+  {
+    return strings;
+  }
+
+  std::pmr::vector< std::pmr::string > PmrSplit( const std::pmr::string& s )
+  {
+    std::pmr::vector< std::pmr::string > ret;
+    for( char c : s )
+    {
+      ret.emplace_back( 1, c );
+    }
+    return ret;
+  }
+
+  std::pmr::map< std::pmr::string, int > PmrLengths( const std::pmr::vector< std::pmr::string >& strings )
+  {
+    std::pmr::map< std::pmr::string, int > ret;
+    for( const auto& s : strings )
+    {
+      ret[ s ] = static_cast< int >( s.size() );
+    }
+    return ret;
+  }
+}
+
+#endif //#ifndef MICROPYTHON_WRAP_TESTS_PMR_H
@@ -0,0 +1,29 @@
+import upywraptest
+
+if not upywraptest.HasBoundDef():
+  print('SKIP')
+  raise SystemExit()
+
+simple = upywraptest.Simple(1)
+simple.BoundAdd(2)
+print(simple.BoundValue())
+print(simple.BoundSimpleFunc(upywraptest.Simple(3)).Value())
+simple.BoundPlus(rh=upywraptest.Simple(4))
+print(simple.BoundValue())
+print(upywraptest.Simple2().BoundValue())
+
+print(upywraptest.BoundFunc7(1, 2, 3, 4))
+upywraptest.BoundEight(1, 2, 3, 4, 5, 6, 7, 8)
+upywraptest.BoundTwoKw(1)
+upywraptest.BoundTwoKw(b=3, a=4)
+upywraptest.KwargsTest().BoundTwoKw(b=5)
+
+try:
+  simple.BoundAdd('a')
+except TypeError:
+  print('TypeError')
+
+try:
+  upywraptest.BoundFunc7(1)
+except TypeError:
+  print('TypeError')
@@ -0,0 +1,59 @@
+import upywraptest
+
+b = upywraptest.FloatBuffer(4)
+m = memoryview(b)
+print(len(m), m[0])
+
+# Writes go straight to the native memory.
+m[1] = 2.5
+m[3] = 1.5
+print(b.Sum(), m[1])
+
+# Read-only buffer.
+c = upywraptest.ConstBytes()
+print(bytes(c))
+print(list(memoryview(c)))
+try:
+  memoryview(c)[0] = 5
+except TypeError:
+  print('TypeError')
+
+# Objects without buffer.
+try:
+  memoryview(upywraptest.Simple(1))
+except TypeError:
+  print('TypeError')
+
+# Functions taking a view work on the buffer's memory directly.
+import array
+a = array.array('f', [0.5, 1.5])
+print(upywraptest.SumView(a), upywraptest.SumView(b))
+d = bytearray(3)
+upywraptest.FillView(d, 7)
+print(d)
+upywraptest.FillView(memoryview(d)[1:], 8)
+print(d)
+
+try:
+  upywraptest.SumView(array.array('d', [1]))
+except TypeError:
+  print('TypeError')
+
+try:
+  upywraptest.FillView(b'abc', 1)
+except TypeError:
+  print('TypeError')
+
+try:
+  upywraptest.FillView(c, 1)
+except TypeError:
+  print('TypeError')
+
+# Returned without copying, and usable as buffer.
+x = upywraptest.MakeFloats(4)
+m = memoryview(x)
+print(len(x), len(m), m[3])
+m[0] = 0.5
+print(upywraptest.SumView(x), list(memoryview(upywraptest.MakeFloats(2))))
+print(array.array('f', bytes(upywraptest.MakeFloats(3))))
+print(len(upywraptest.StoredFloats()), len(upywraptest.StoredFloats()))
@@ -24,6 +24,10 @@ try:
   simple1.val2
 except AttributeError:
   print('AttributeError')
+try:
+  simple1.val2 = 1
+except AttributeError:
+  print('AttributeError')
 
 print(simple1 == simple2)
 print(simple1 == simple1)
@@ -119,3 +123,12 @@ print(derived1, derived3, simple1)
 print(upywraptest.Simple(4) == derived1)
 print(derived1 == upywraptest.Simple(3))
 print(derived1 == Derived3(4))
+
+# Methods can be replaced or removed from uPy.
+value = upywraptest.Simple.Value
+upywraptest.Simple.Value = lambda self: -1
+print(simple1.Value())
+del upywraptest.Simple.Value
+print(hasattr(simple1, 'Value'))
+upywraptest.Simple.Value = value
+print(simple1.Value())
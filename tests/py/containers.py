@@ -0,0 +1,81 @@
+import upywraptest
+
+m = upywraptest.UnorderedMap({'a': 1, 'b': 2})
+print([(k, m[k]) for k in sorted(m.keys())])
+try:
+  upywraptest.UnorderedMap([('a', 1)])
+except TypeError:
+  print('TypeError')
+
+s = upywraptest.Set({3, 1, 2})
+print(type(s) is set, sorted(s))
+print(sorted(upywraptest.Set([2, 2, 5])), sorted(upywraptest.Set(range(3))))
+print(sorted(upywraptest.UnorderedSet(['a', 'b', 'a'])))
+print(sorted(upywraptest.UnorderedSet(frozenset(['c']))))
+
+# Any iterable converts to sequence containers.
+print(upywraptest.Deque([1, 2]), upywraptest.Deque((3,)), upywraptest.Deque(x * 2 for x in range(3)))
+print(upywraptest.List(['a', 'b', 'c']), upywraptest.List('de'), upywraptest.List([]))
+
+print(upywraptest.Array3([1, 2, 3.5]), upywraptest.Array3((0, 0, 1)))
+try:
+  upywraptest.Array3([1, 2])
+except ValueError:
+  print('ValueError')
+
+try:
+  upywraptest.Set([1, 'a'])
+except TypeError:
+  print('TypeError')
+
+# Views on native containers, converting items only when accessed.
+import gc
+s = upywraptest.Samples(1000)
+v = s.Values()
+print(len(v), v[0], v[999], v[-1], v[2:5], v[::-400], v[5:2])
+print(3 in v, -1 in v, sum(v))
+try:
+  v[1000]
+except IndexError:
+  print('IndexError')
+n = s.Names()
+print(len(n), n['s10'], 's3' in n, 'x' in n, sorted(n.keys())[:2])
+print(len(list(n)), list(n)[:2], sum(1 for k in n if k.startswith('s99')))
+try:
+  n['x']
+except KeyError:
+  print('KeyError')
+print(1 in n, None in n)
+try:
+  n[1]
+except TypeError:
+  print('TypeError')
+
+# The views keep the object alive.
+s = None
+gc.collect()
+print(v[1], n['s1'])
+
+l = upywraptest.ListView()
+print(list(l), l[1], l[-1:], l[::-1], l[::2], l[2:0:-2])
+
+# Iterables are consumed one item at a time.
+print(upywraptest.SumIterable(x * 0.5 for x in range(1000)), upywraptest.SumIterable([1, 2]), upywraptest.SumIterable(()))
+
+def Forever():
+  i = 0
+  while True:
+    yield str(i)
+    i += 1
+
+gen = Forever()
+print(upywraptest.TakeFromIterable(gen, 3), upywraptest.TakeFromIterable(gen, 2))
+print(upywraptest.TakeFromIterable('ab', 5))
+try:
+  upywraptest.SumIterable(1)
+except TypeError:
+  print('TypeError')
+try:
+  upywraptest.SumIterable([1, 'a'])
+except TypeError:
+  print('TypeError')
@@ -0,0 +1,13 @@
+import gc
+import upywraptest
+
+for i in range(10):
+  upywraptest.Deferred()
+  gc.collect()
+
+# Collected instances only get queued.
+pending = upywraptest.PendingFinalizers()
+print(upywraptest.DeferredDestroyed(), 'destroyed', 'pending' if pending > 0 else 'none pending')
+
+print(upywraptest.DrainFinalizers(1) == pending - 1, upywraptest.DeferredDestroyed())
+print(upywraptest.DrainFinalizers(100), upywraptest.DeferredDestroyed() == pending)
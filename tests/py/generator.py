@@ -0,0 +1,30 @@
+import upywraptest
+
+if not upywraptest.HasCoroutines():
+  print('SKIP')
+  raise SystemExit()
+
+print(list(upywraptest.Range(5)), list(upywraptest.Range(0)))
+print(sum(upywraptest.Range(100000)))
+print(list(upywraptest.Words('a bc def')))
+
+g = upywraptest.Range(3)
+print(iter(g) is g, next(g), next(g), next(g))
+try:
+  next(g)
+except StopIteration:
+  print('StopIteration')
+print(list(g))
+
+# Stop early, the rest is never produced.
+for i in upywraptest.Range(1000000):
+  if i == 2:
+    break
+print(i)
+
+g = upywraptest.ThrowAfter(2)
+print(next(g), next(g))
+try:
+  next(g)
+except RuntimeError as e:
+  print(e)
@@ -0,0 +1,25 @@
+import upywraptest
+
+p = upywraptest.Point(1, 2)
+print(p.X(), p.Y(), p.IsAligned())
+p.Move(1, 1)
+print(p)
+
+# Returned by value.
+s = p.Scaled(2)
+print(s, s.IsAligned())
+print(upywraptest.Midpoint(p, s))
+
+# References and shared_ptr get copied.
+m = p.Moved(1)
+m.Move(10, 10)
+print(p, m)
+q = upywraptest.SharedPoint(p)
+q.Move(1, 1)
+print(p, q)
+
+points = [upywraptest.Point(i, -i) for i in range(100)]
+print(sum(x.X() for x in points), all(x.IsAligned() for x in points))
+
+# Nothing to destruct so no finaliser.
+print(hasattr(p, '__del__'), hasattr(upywraptest.Simple(0), '__del__'))
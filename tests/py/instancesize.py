@@ -0,0 +1,9 @@
+import upywraptest
+
+sizes = upywraptest.InstanceSizes()
+base = sizes['base']
+
+# Instances only hold the type pointer next to the native object, whatever that is
+# (shared_ptr or pointer) for Simple, and for Point, stored inline, some alignment padding at most.
+print(sizes['Simple'] == base + sizes['SimpleObj'])
+print(base <= sizes['Point'] - sizes['PointObj'] < base + 8)
@@ -2,5 +2,15 @@ import upywraptest
 
 m = upywraptest.Map1({"a": 1, "b": 2, "def": 444})
 print([(k, m[k]) for k in sorted(m.keys())])
+m = upywraptest.MapDescending({"a": 1, "b": 2, "def": 444})
+print([(k, m[k]) for k in sorted(m.keys())])
+# Large enough to get converted in sorted order.
+d = {i: str(i) for i in range(50)}
+print(upywraptest.MapCopy(d) == d, upywraptest.MapCopy({}) == {})
+print(upywraptest.MapDescendingValues({i: -i for i in range(20)}))
 m = upywraptest.Map2({"a": [1], "b": [2]})
 print([(k, m[k]) for k in sorted(m.keys())])
+# Keys which exist as qstr and keys which don't must both behave like any other str key.
+d = {"append": 1, "keys": 2, "not" + "aqstr" * 3: 3}
+m = upywraptest.MapStringKeysCopy(d)
+print(m == d, m["append"], m["keys"], m["notaqstraqstraqstr"], "append" in m, "appen" in m)
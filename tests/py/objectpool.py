@@ -0,0 +1,22 @@
+import gc
+import upywraptest
+
+total = 0
+for i in range(20):
+  total += upywraptest.Pooled(i).Value()
+  gc.collect()
+
+hits, misses, size = upywraptest.PoolCounters()
+print(total, hits + misses, size <= 4)
+print('pool used' if hits > 0 else 'pool not used')
+
+# Values returned by native functions come from the pool as well.
+hits0, misses0, size0 = upywraptest.PoolCounters()
+p = upywraptest.MakePooled(0)
+for i in range(20):
+  p = p.Plus(i)
+  gc.collect()
+
+hits, misses, size = upywraptest.PoolCounters()
+print(p.Value(), hits + misses - hits0 - misses0, size <= 4)
+print('pool used' if hits > hits0 else 'pool not used')
@@ -0,0 +1,89 @@
+import gc
+import upywraptest
+
+a = upywraptest.Number(1)
+b = upywraptest.Number(2)
+
+print((a + b).Value())
+print(b - a)
+print((a * 3).Value())
+print(a == b, a == upywraptest.Number(1), a != b)
+print(a < b, b < a)
+
+# Also available as methods.
+print(a.__add__(b).Value())
+print(a.__sub__(b))
+
+try:
+  a + 1
+except TypeError:
+  print('TypeError')
+
+try:
+  a / b
+except TypeError:
+  print('TypeError')
+
+# Python subclasses go through the methods.
+class Derived(upywraptest.Number):
+  def __init__(self, value):
+    super().__init__(value)
+
+print((Derived(4) + a).Value())
+print(Derived(4) - Derived(1))
+
+# Unary operators.
+print(-a, -Derived(4))
+print(bool(a), bool(upywraptest.Number(0)), not a)
+print(hash(b), a.__hash__())
+
+# Hashes outside the small int range still work for dict and set lookups.
+h = upywraptest.Number(-1)
+print({h: 'h'}[h], h in {h}, hash(h) == hash(h))
+
+# Unregistered unary operators are not supported.
+try:
+  ~a
+except TypeError:
+  print('TypeError')
+
+# Subscript and len.
+n = upywraptest.Numbers()
+print(len(n), bool(n))
+n.Add(1)
+n.Add(2)
+n.Add(3)
+print(len(n), bool(n), n[0], n[2])
+n[1] = 5
+print(n[1], n.__getitem__(1))
+del n[0]
+print(len(n), n[0], n[1])
+
+# Native iteration.
+n.Add(7)
+print(list(n), [x * 2 for x in n], 7 in n, 8 in n)
+it = iter(n)
+print(next(it), next(it), list(it), list(it))
+print(list(upywraptest.Numbers()))
+# The iterator keeps the object alive, and needs no finaliser for a std::vector iterator.
+m = upywraptest.Numbers()
+m.Add(1)
+it = iter(m)
+m = None
+gc.collect()
+print(list(it), hasattr(it, '__del__'))
+
+try:
+  n[5]
+except RuntimeError:
+  print('RuntimeError')
+
+try:
+  del n[5]
+except RuntimeError:
+  print('RuntimeError')
+
+try:
+  a[0]
+except TypeError:
+  print('TypeError')
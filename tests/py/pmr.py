@@ -0,0 +1,22 @@
+import upywraptest
+
+if not upywraptest.HasPmr():
+  print('SKIP')
+  raise SystemExit()
+
+print(upywraptest.PmrStrings(['a', 'bc', 'a long string which does not fit in small string buffers']))
+print(upywraptest.PmrStrings([]))
+print(upywraptest.PmrMap({'a': [1, 2], 'b': [3], 'c': []}))
+print(upywraptest.PmrSplit('abc'), upywraptest.PmrSplit(''))
+m = upywraptest.PmrLengths(['a', 'bc', 'a'])
+print([(k, m[k]) for k in sorted(m.keys())])
+
+# Larger than UPYWRAP_SCRATCHARENASIZE so the arena, if used, has to get more memory; the return value
+# also is converted before the arena goes away.
+s = ['x' * 100 for i in range(20)]
+print(upywraptest.PmrStrings(s), upywraptest.PmrEcho(s) == s)
+
+try:
+  upywraptest.PmrStrings([1])
+except TypeError:
+  print('TypeError')
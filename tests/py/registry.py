@@ -0,0 +1,7 @@
+import upywraptest
+
+# Many methods, registered in bulk.
+print(upywraptest.Registry10().f0(), upywraptest.Registry10().f9())
+print(upywraptest.Registry100().f0(), upywraptest.Registry100().f99())
+print(upywraptest.Registry1000().f0(), upywraptest.Registry1000().f999())
+print(hasattr(upywraptest.Registry10(), 'f10'))
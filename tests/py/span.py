@@ -0,0 +1,16 @@
+import upywraptest
+import array
+
+if not upywraptest.HasSpan():
+  print('SKIP')
+  raise SystemExit()
+
+print(upywraptest.SumSpan(array.array('f', [0.5, 1.5])))
+d = bytearray(2)
+upywraptest.FillSpan(d, 3)
+print(d)
+
+try:
+  upywraptest.FillSpan(b'ab', 1)
+except TypeError:
+  print('TypeError')
@@ -2,3 +2,61 @@ import upywraptest
 
 print(upywraptest.Vector1([0, 1, 2, 3]))
 print(upywraptest.Vector2(['a', 'b', 'cdefg']))
+
+# Anything with the buffer protocol converts to vectors of numbers.
+import array
+print(upywraptest.Vector1(array.array('i', [4, 5])))
+print(upywraptest.SumBytes(b'\x01\x02\x03'), upywraptest.SumBytes(bytearray([4, 5])))
+print(upywraptest.SumFloats(array.array('f', [0.5, 1.5])))
+print(upywraptest.SumInt64(array.array('q', [1, -2])))
+
+# Mismatching typecodes get converted per item.
+print(upywraptest.SumFloats(array.array('d', [0.5, 1.5])), upywraptest.SumFloats(array.array('h', [1, 2])))
+print(upywraptest.Vector1(array.array('B', [6, 7])))
+print(upywraptest.SumBytes(array.array('i', [1, 2])))
+try:
+  upywraptest.SumBytes(array.array('i', [256]))
+except OverflowError:
+  print('OverflowError')
+
+# Strings are not converted.
+try:
+  upywraptest.SumBytes('abc')
+except TypeError:
+  print('TypeError')
+
+# Return as array or bytearray instead of list.
+print(upywraptest.FloatsAsArray([0.5, 1.5]), upywraptest.FloatsAsArray([]))
+print(upywraptest.IntsAsArray([1, -2]))
+print(upywraptest.BytesAsByteArray([1, 2]))
+print(upywraptest.FloatsAsArray(upywraptest.FloatsAsArray([2.5])))
+
+# Lists of numbers: bulk conversion and fallback for other items.
+print(upywraptest.SumBytes([1, 2, 255]), upywraptest.SumInt64([1, -2, 2 ** 40]))
+print(upywraptest.SumFloats([1, 0.5, -2]), upywraptest.SumFloats((True, 0.5)))
+print(upywraptest.Vector1([1, True, -3]))
+try:
+  upywraptest.SumBytes([1, 256])
+except OverflowError:
+  print('OverflowError')
+try:
+  upywraptest.SumBytes([-1, 1])
+except TypeError:
+  print('TypeError')
+try:
+  upywraptest.SumFloats([1, 1e39])
+except OverflowError:
+  print('OverflowError')
+try:
+  upywraptest.SumFloats([1, 'a'])
+except TypeError:
+  print('TypeError')
+
+# Integers which do and don't fit in small ints.
+print(upywraptest.VectorInt64([-5, 5, 2 ** 30]))
+print(upywraptest.VectorInt64([-(2 ** 63), 2 ** 63 - 1, 0]))
+print(upywraptest.VectorUnsigned64([0, 2 ** 64 - 1]))
+print(upywraptest.VectorInt64([]))
+
+# Vectors with an allocator other than std::allocator.
+print(upywraptest.VectorCustomAllocator([2, 3]))
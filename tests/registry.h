@@ -0,0 +1,60 @@
+#ifndef MICROPYTHON_WRAP_TESTS_REGISTRY_H
+#define MICROPYTHON_WRAP_TESTS_REGISTRY_H
+
+#include <cstddef>
+#include <string>
+
+namespace upywrap
+{
+  //Type with N registered methods f0, f1, ..., all returning N, for timing calls
+  //against the number of registered functions, see tests/bench/calls.py.
+  template< std::size_t N >
+  class Registry
+  {
+  public:
+    int Value() const
+    {
+      return static_cast< int >( N );
+    }
+  };
+
+  template< std::size_t I >
+  const char* MethodName()
+  {
+    static const std::string name = "f" + std::to_string( I );
+    return name.c_str();
+  }
+
+  template< std::size_t Offset, std::size_t N, std::size_t... I >
+  void DefRegistryMethods( ClassWrapper< Registry< N > >& reg, index_sequence< I... > )
+  {
+    const int dummy[] = { 0, ( reg.template Def< MethodName< Offset + I > >( &Registry< N >::Value ), 0 )... };
+    (void) dummy;
+  }
+
+  //In blocks of 100 to stay clear of the template recursion limit of make_index_sequence.
+  template< std::size_t N, std::size_t... Block >
+  void DefRegistryBlocks( ClassWrapper< Registry< N > >& reg, index_sequence< Block... > )
+  {
+    const int dummy[] = { 0, ( DefRegistryMethods< Block * 100 >( reg, make_index_sequence< 100 >() ), 0 )... };
+    (void) dummy;
+  }
+
+  //N must be less than 100 or a multiple of it.
+  template< std::size_t N >
+  void DefRegistry( const char* name, mp_obj_dict_t* mod )
+  {
+    ClassWrapper< Registry< N > > reg( name, mod );
+    reg.DefInit();
+    if( N < 100 )
+    {
+      DefRegistryMethods< 0 >( reg, make_index_sequence< N % 100 >() );
+    }
+    else
+    {
+      DefRegistryBlocks( reg, make_index_sequence< N / 100 >() );
+    }
+  }
+}
+
+#endif //#ifndef MICROPYTHON_WRAP_TESTS_REGISTRY_H
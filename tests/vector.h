@@ -2,7 +2,10 @@
 #define MICROPYTHON_WRAP_TESTS_VECTOR_H
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
+#include <numeric>
 #include <vector>
 
 namespace upywrap
@@ -14,6 +17,82 @@ namespace upywrap
     std::cout << std::endl;
     return x;
   }
+
+  template< class T >
+  double SumVector( std::vector< T > x )
+  {
+    return std::accumulate( x.cbegin(), x.cend(), 0.0 );
+  }
+
+  template< class T >
+  std::vector< T > Iota( T start, int n )
+  {
+    std::vector< T > x( static_cast< std::size_t >( n ) );
+    std::iota( x.begin(), x.end(), start );
+    return x;
+  }
+
+  template< class T >
+  AsArray< std::vector< T > > VectorAsArray( std::vector< T > x )
+  {
+    return x;
+  }
+
+  AsByteArray< std::vector< std::uint8_t > > VectorAsByteArray( std::vector< std::uint8_t > x )
+  {
+    return x;
+  }
+
+  //Minimal allocator which is not std::allocator, to check conversion doesn't depend on that.
+  template< class T >
+  struct CountingAllocator
+  {
+    typedef T value_type;
+
+    CountingAllocator()
+    {
+    }
+
+    template< class U >
+    CountingAllocator( const CountingAllocator< U >& )
+    {
+    }
+
+    T* allocate( std::size_t n )
+    {
+      ++NumAllocations();
+      return std::allocator< T >().allocate( n );
+    }
+
+    void deallocate( T* p, std::size_t n )
+    {
+      std::allocator< T >().deallocate( p, n );
+    }
+
+    static int& NumAllocations()
+    {
+      static int numAllocations = 0;
+      return numAllocations;
+    }
+  };
+
+  template< class T, class U >
+  bool operator == ( const CountingAllocator< T >&, const CountingAllocator< U >& )
+  {
+    return true;
+  }
+
+  template< class T, class U >
+  bool operator != ( const CountingAllocator< T >&, const CountingAllocator< U >& )
+  {
+    return false;
+  }
+
+  std::vector< int, CountingAllocator< int > > VectorCustomAllocator( std::vector< int, CountingAllocator< int > > x )
+  {
+    x.push_back( CountingAllocator< int >::NumAllocations() > 0 ? 1 : 0 );
+    return x;
+  }
 }
 
 #endif //#ifndef MICROPYTHON_WRAP_TESTS_VECTOR_H